@@ -4,6 +4,7 @@
 
 #include "tipos.hpp"
 
+#include <cstddef>
 #include <queue>
 #include <unordered_map>
 #include <vector>
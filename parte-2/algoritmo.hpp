@@ -7,6 +7,10 @@
 #include "abierta.hpp"
 #include "cerrada.hpp"
 
+#include <chrono>
+#include <functional>
+#include <queue>
+#include <stack>
 #include <vector>
 
 struct SolucionAStar {
@@ -17,22 +21,317 @@ struct SolucionAStar {
     double elapsed = 0.0;
 };
 
+// The searches are templates over the graph layout, like Rango: any type with hasVertex(),
+// getIndice(), getVertexPorIndice(), forEachAdyacente() and isUnreachablePorIndice()
+// works (Grafo and GrafoComprimido). Abierta/Cerrada hold internal indices; the
+// returned path is translated back to DIMACS ids.
 class Algoritmo {
 private:
     Abierta abierta;
     Cerrada cerrada;
 
+    // Fills path/costs of 'res' from the parent chain goal -> start (internal indices)
+    template <typename G>
+    void buildPath(const G& g, size_t start, size_t goal, SolucionAStar& res) const;
+
 public:
     Algoritmo() = default;
 
-    SolucionAStar solveAStar(const Grafo& g, VertexID start, VertexID goal);
+    template <typename G>
+    SolucionAStar solveAStar(const G& g, VertexID start, VertexID goal) {
+        return solveWeightedAStar(g, start, goal, 1.0);
+    }
+
+    // Bounded-suboptimal: cost <= epsilon * optimal (epsilon >= 1, checked by the caller)
+    template <typename G>
+    SolucionAStar solveWeightedAStar(const G& g, VertexID start, VertexID goal, double epsilon);
 
     // Non-optimal on weighted graphs (for comparison only)
-    SolucionAStar solveBFS(const Grafo& g, VertexID start, VertexID goal);
-    SolucionAStar solveDFS(const Grafo& g, VertexID start, VertexID goal);
+    template <typename G>
+    SolucionAStar solveBFS(const G& g, VertexID start, VertexID goal);
+    template <typename G>
+    SolucionAStar solveDFS(const G& g, VertexID start, VertexID goal);
 
     // Optimal brute-force baseline for weighted graphs
-    SolucionAStar solveDijkstra(const Grafo& g, VertexID start, VertexID goal);
+    template <typename G>
+    SolucionAStar solveDijkstra(const G& g, VertexID start, VertexID goal);
+
+    // Straight-line (haversine) distance in meters, the heuristic of every A* variant
+    static Distance haversine(const Vertex& a, const Vertex& b);
 };
 
+// ------------------------------------------------------------
+// Path rebuilt from the parent chain
+// ------------------------------------------------------------
+template <typename G>
+void Algoritmo::buildPath(const G& g, size_t start, size_t goal, SolucionAStar& res) const {
+    std::vector<VertexID> chain = cerrada.reconstructPath(static_cast<VertexID>(goal), static_cast<VertexID>(start));
+    res.costs = cerrada.getEdgeCosts(chain);
+
+    res.path.clear();
+    for (VertexID v : chain) res.path.push_back(g.getVertexPorIndice(v).id);
+}
+
+// ------------------------------------------------------------
+// Weighted A*: f = g + epsilon * h
+// ------------------------------------------------------------
+// With a consistent h the returned cost is at most epsilon times the optimum;
+// epsilon = 1 is plain A*.
+template <typename G>
+SolucionAStar Algoritmo::solveWeightedAStar(const G& g, VertexID start, VertexID goal, double epsilon) {
+    auto t0 = std::chrono::high_resolution_clock::now();
+
+    SolucionAStar res;
+    res.total_cost = INFINITY_DIST;
+
+    // validaion of the the existance of start and goal verctices
+    if (!g.hasVertex(start) || !g.hasVertex(goal) ||
+        g.isUnreachablePorIndice(g.getIndice(start), g.getIndice(goal))) {
+        auto t1 = std::chrono::high_resolution_clock::now();
+        res.elapsed = std::chrono::duration_cast<std::chrono::duration<double>>(t1 - t0).count();
+        return res;
+    }
+
+    const VertexID s = static_cast<VertexID>(g.getIndice(start));
+    const VertexID t = static_cast<VertexID>(g.getIndice(goal));
+
+    // we reset the data strucutes for a new search
+    abierta = Abierta();
+    cerrada = Cerrada();
+    size_t expansions = 0;
+
+    // Heuristic function:
+    // we use the haversine distance to calculate the distance in a straight line
+    const Vertex& goal_vertex = g.getVertexPorIndice(t);
+    auto heuristic = [&](VertexID v) -> Distance {
+        return static_cast<Distance>(epsilon * static_cast<double>(haversine(g.getVertexPorIndice(v), goal_vertex)));
+    };
+
+    // we initialize the search adding 
+    cerrada.add(s, INVALID_VERTEX, 0);
+    abierta.push(Node{s, 0, heuristic(s)});
+
+    while (!abierta.empty()) {
+    // pop the best candidate (node with the lowest f = g + h)
+        Node current = abierta.pop();
+
+        // we skip it if we have found a better path to this node already
+        if (current.g_cost != cerrada.getGCost(current.vertex_id)) {
+            continue;
+        }
+
+        expansions++;
+
+        // we have reached the goal so we finalize thre results and we reconstruct the path
+        if (current.vertex_id == t) {
+            auto t1 = std::chrono::high_resolution_clock::now();
+            res.elapsed = std::chrono::duration_cast<std::chrono::duration<double>>(t1 - t0).count();
+            res.expansion_count = expansions;
+            res.total_cost = current.g_cost;
+
+            buildPath(g, s, t, res);
+            return res;
+        }
+
+        // we expand the current node
+        g.forEachAdyacente(current.vertex_id, [&](VertexID nb, Distance cost) {
+            Distance new_g = current.g_cost + cost;
+
+            // relaxation: we update the path to neighbor if we have found a better one
+            Distance old_g = cerrada.getGCost(nb);
+            if (new_g < old_g) {
+                cerrada.add(nb, current.vertex_id, new_g);
+                abierta.push(Node{nb, new_g, heuristic(nb)});
+            }
+        });
+    }
+
+    auto t1 = std::chrono::high_resolution_clock::now();
+    res.elapsed = std::chrono::duration_cast<std::chrono::duration<double>>(t1 - t0).count();
+    res.expansion_count = expansions;
+    return res;
+}
+
+// ------------------------------------------------------------
+// BFS (not optimal for weighted graphs)
+// ------------------------------------------------------------
+template <typename G>
+SolucionAStar Algoritmo::solveBFS(const G& g, VertexID start, VertexID goal) {
+    auto t0 = std::chrono::high_resolution_clock::now();
+
+    SolucionAStar res;
+    res.total_cost = INFINITY_DIST;
+
+    if (!g.hasVertex(start) || !g.hasVertex(goal) ||
+        g.isUnreachablePorIndice(g.getIndice(start), g.getIndice(goal))) {
+        auto t1 = std::chrono::high_resolution_clock::now();
+        res.elapsed = std::chrono::duration_cast<std::chrono::duration<double>>(t1 - t0).count();
+        return res;
+    }
+
+    const VertexID s = static_cast<VertexID>(g.getIndice(start));
+    const VertexID t = static_cast<VertexID>(g.getIndice(goal));
+
+    cerrada = Cerrada();
+    std::queue<VertexID> q;
+
+    cerrada.add(s, INVALID_VERTEX, 0);
+    q.push(s);
+
+    size_t expansions = 0;
+
+    while (!q.empty()) {
+        VertexID u = q.front();
+        q.pop();
+        expansions++;
+
+        if (u == t) break;
+
+        Distance gu = cerrada.getGCost(u);
+
+        g.forEachAdyacente(u, [&](VertexID v, Distance cost) {
+            // we only add it if the vertex has no been visited
+            if (cerrada.getGCost(v) != INFINITY_DIST) return;
+            cerrada.add(v, u, gu + cost);
+            q.push(v);
+        });
+    }
+
+    auto t1 = std::chrono::high_resolution_clock::now();
+    res.elapsed = std::chrono::duration_cast<std::chrono::duration<double>>(t1 - t0).count();
+    res.expansion_count = expansions;
+
+    if (cerrada.getGCost(t) != INFINITY_DIST) {
+        res.total_cost = cerrada.getGCost(t);
+        buildPath(g, s, t, res);
+    }
+
+    return res;
+}
+
+// ------------------------------------------------------------
+// DFS (not optimal for weighted graphs)
+// ------------------------------------------------------------
+template <typename G>
+SolucionAStar Algoritmo::solveDFS(const G& g, VertexID start, VertexID goal) {
+    auto t0 = std::chrono::high_resolution_clock::now();
+
+    SolucionAStar res;
+    res.total_cost = INFINITY_DIST;
+
+    if (!g.hasVertex(start) || !g.hasVertex(goal) ||
+        g.isUnreachablePorIndice(g.getIndice(start), g.getIndice(goal))) {
+        auto t1 = std::chrono::high_resolution_clock::now();
+        res.elapsed = std::chrono::duration_cast<std::chrono::duration<double>>(t1 - t0).count();
+        return res;
+    }
+
+    const VertexID s = static_cast<VertexID>(g.getIndice(start));
+    const VertexID t = static_cast<VertexID>(g.getIndice(goal));
+
+    cerrada = Cerrada();
+    std::stack<VertexID> st;
+
+    cerrada.add(s, INVALID_VERTEX, 0);
+    st.push(s);
+
+    size_t expansions = 0;
+
+    while (!st.empty()) {
+        VertexID u = st.top();
+        st.pop();
+        expansions++;
+
+        if (u == t) break;
+
+        Distance gu = cerrada.getGCost(u);
+
+        g.forEachAdyacente(u, [&](VertexID v, Distance cost) {
+            // we only add it if the vertex has no been visited
+            if (cerrada.getGCost(v) != INFINITY_DIST) return;
+            cerrada.add(v, u, gu + cost);
+            st.push(v);
+        });
+    }
+
+    auto t1 = std::chrono::high_resolution_clock::now();
+    res.elapsed = std::chrono::duration_cast<std::chrono::duration<double>>(t1 - t0).count();
+    res.expansion_count = expansions;
+
+    if (cerrada.getGCost(t) != INFINITY_DIST) {
+        res.total_cost = cerrada.getGCost(t);
+        buildPath(g, s, t, res);
+    }
+
+    return res;
+}
+
+// ------------------------------------------------------------
+// Dijkstra / Uniform-Cost Search
+// ------------------------------------------------------------
+template <typename G>
+SolucionAStar Algoritmo::solveDijkstra(const G& g, VertexID start, VertexID goal) {
+    auto t0 = std::chrono::high_resolution_clock::now();
+
+    SolucionAStar res;
+    res.total_cost = INFINITY_DIST;
+
+    if (!g.hasVertex(start) || !g.hasVertex(goal) ||
+        g.isUnreachablePorIndice(g.getIndice(start), g.getIndice(goal))) {
+        auto t1 = std::chrono::high_resolution_clock::now();
+        res.elapsed = std::chrono::duration_cast<std::chrono::duration<double>>(t1 - t0).count();
+        return res;
+    }
+
+    const VertexID s = static_cast<VertexID>(g.getIndice(start));
+    const VertexID t = static_cast<VertexID>(g.getIndice(goal));
+
+    // Min-heap based on g_cost
+    struct QItem {
+        VertexID v;
+        Distance g;
+        bool operator>(const QItem& o) const { return g > o.g; }
+    };
+
+    std::priority_queue<QItem, std::vector<QItem>, std::greater<QItem>> pq;
+
+    cerrada = Cerrada();
+    cerrada.add(s, INVALID_VERTEX, 0);
+    pq.push({s, 0});
+
+    size_t expansions = 0;
+
+    while (!pq.empty()) {
+        auto cur = pq.top();
+        pq.pop();
+
+        // skip if we have foundd a better path to cur.v already
+        if (cur.g != cerrada.getGCost(cur.v)) continue;
+
+        expansions++;
+
+        if (cur.v == t) {
+            res.total_cost = cur.g;
+            break;
+        }
+
+        g.forEachAdyacente(cur.v, [&](VertexID nb, Distance cost) {
+            Distance new_g = cur.g + cost;
+
+            if (new_g < cerrada.getGCost(nb)) {
+                cerrada.add(nb, cur.v, new_g);
+                pq.push({nb, new_g});
+            }
+        });
+    }
+
+    auto t1 = std::chrono::high_resolution_clock::now();
+    res.elapsed = std::chrono::duration_cast<std::chrono::duration<double>>(t1 - t0).count();
+    res.expansion_count = expansions;
+
+    if (res.total_cost != INFINITY_DIST) buildPath(g, s, t, res);
+
+    return res;
+}
+
 #endif // ALGORITMO_HPP
@@ -0,0 +1,203 @@
+// ara.cpp
+#include "ara.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <limits>
+
+void AraStar::prepare(const Grafo& g) {
+    // the heuristic cache is cleared through the vertices the last search touched
+    if (estado.size() != g.getNumVertices()) {
+        estado.init(g.getNumVertices());
+        h_cache.assign(g.getNumVertices(), INFINITY_DIST);
+        closed_iter.assign(g.getNumVertices(), 0);
+        in_incons.assign(g.getNumVertices(), 0);
+        stamp = 0;
+    } else {
+        for (VertexID v : estado.getTouched()) h_cache[v] = INFINITY_DIST;
+        estado.reset();
+    }
+    for (VertexID v : incons) in_incons[v] = 0;
+    incons.clear();
+    open.clear();
+}
+
+Distance AraStar::heuristic(const Grafo& g, size_t v, const Vertex& goal) {
+    if (h_cache[v] == INFINITY_DIST) h_cache[v] = Algoritmo::haversine(g.getVertexPorIndice(v), goal);
+    return h_cache[v];
+}
+
+bool AraStar::isStale(const QItem& item) const {
+    return item.g != estado.getDist(item.v) || closed_iter[item.v] == stamp;
+}
+
+// epsilon' = g(goal) / min over OPEN and INCONS of (g + h): a proven suboptimality bound
+double AraStar::currentBound(const Grafo& g, const Vertex& goal, Distance goal_cost) {
+    Distance lower = INFINITY_DIST;
+    for (const auto& item : open) {
+        if (!isStale(item)) lower = std::min(lower, item.g + heuristic(g, item.v, goal));
+    }
+    for (VertexID v : incons) {
+        lower = std::min(lower, estado.getDist(v) + heuristic(g, v, goal));
+    }
+
+    if (lower == INFINITY_DIST || lower >= goal_cost) return 1.0; // nothing left can improve it
+    if (lower == 0) return std::numeric_limits<double>::infinity();
+    return static_cast<double>(goal_cost) / static_cast<double>(lower);
+}
+
+// OPEN <- OPEN u INCONS with the keys of the new epsilon
+void AraStar::rekey(const Grafo& g, const Vertex& goal, double epsilon) {
+    std::vector<QItem> next;
+    next.reserve(open.size() + incons.size());
+
+    // in_incons doubles as the "already collected" mark
+    for (VertexID v : incons) {
+        next.push_back({v, 0, estado.getDist(v)});
+    }
+    for (const auto& item : open) {
+        if (isStale(item) || in_incons[item.v]) continue;
+        in_incons[item.v] = 1;
+        incons.push_back(item.v);
+        next.push_back({item.v, 0, item.g});
+    }
+    for (VertexID v : incons) in_incons[v] = 0;
+    incons.clear();
+
+    for (auto& item : next) {
+        item.key = item.g + static_cast<Distance>(epsilon * static_cast<double>(heuristic(g, item.v, goal)));
+    }
+    std::make_heap(next.begin(), next.end(), std::greater<QItem>());
+    open = std::move(next);
+}
+
+SolucionARA AraStar::solve(const Grafo& g, VertexID start, VertexID goal, double epsilon0, double deadline_seconds) {
+    auto t0 = std::chrono::high_resolution_clock::now();
+    auto seconds = [&]() {
+        auto t1 = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration_cast<std::chrono::duration<double>>(t1 - t0).count();
+    };
+
+    SolucionARA res;
+    res.best.total_cost = INFINITY_DIST;
+
+    if (!g.hasVertex(start) || !g.hasVertex(goal) || g.isUnreachable(start, goal)) {
+        res.best.elapsed = seconds();
+        return res;
+    }
+
+    prepare(g);
+
+    const size_t s = g.getIndice(start);
+    const size_t t = g.getIndice(goal);
+    const Vertex& goal_vertex = g.getVertexPorIndice(t);
+
+    double epsilon = epsilon0;
+    const double step = std::max(0.0, (epsilon - 1.0) / 4.0); // at most 4 inflated iterations
+
+    stamp++;
+    estado.update(s, INVALID_VERTEX, 0);
+    open.push_back({static_cast<VertexID>(s),
+                    static_cast<Distance>(epsilon * static_cast<double>(heuristic(g, s, goal_vertex))), 0});
+
+    size_t total_expansions = 0;
+
+    while (true) {
+        IteracionARA it;
+        it.epsilon = epsilon;
+        bool timed_out = false;
+
+        // ImprovePath: weighted A* until no OPEN key beats the current goal cost
+        while (!open.empty()) {
+            const QItem top = open.front();
+            if (isStale(top)) {
+                std::pop_heap(open.begin(), open.end(), std::greater<QItem>());
+                open.pop_back();
+                continue;
+            }
+            if (estado.getDist(t) <= top.key) break;
+
+            // we only look at the clock every 256 expansions
+            if ((it.expansions & 255) == 255 && seconds() > deadline_seconds) {
+                timed_out = true;
+                break;
+            }
+
+            std::pop_heap(open.begin(), open.end(), std::greater<QItem>());
+            open.pop_back();
+            closed_iter[top.v] = stamp;
+            it.expansions++;
+
+            for (const auto& e : g.getAdyacentesPorIndice(top.v)) {
+                Distance new_g = top.g + e.cost;
+                if (new_g >= estado.getDist(e.target_index)) continue;
+
+                estado.update(e.target_index, top.v, new_g);
+
+                // already expanded in this iteration: it waits in INCONS for the next one
+                if (closed_iter[e.target_index] == stamp) {
+                    if (!in_incons[e.target_index]) {
+                        in_incons[e.target_index] = 1;
+                        incons.push_back(e.target_index);
+                    }
+                } else {
+                    Distance h = heuristic(g, e.target_index, goal_vertex);
+                    open.push_back({e.target_index, new_g + static_cast<Distance>(epsilon * static_cast<double>(h)), new_g});
+                    std::push_heap(open.begin(), open.end(), std::greater<QItem>());
+                }
+            }
+        }
+
+        total_expansions += it.expansions;
+
+        // an interrupted iteration does not give a bound
+        if (timed_out) break;
+
+        const Distance goal_cost = estado.getDist(t);
+        if (goal_cost == INFINITY_DIST) break; // unreachable
+
+        it.cost = goal_cost;
+        it.bound = std::min(epsilon, currentBound(g, goal_vertex, goal_cost));
+        it.elapsed = seconds();
+
+        // we publish the solution of this iteration
+        if (goal_cost < res.best.total_cost || res.best.path.empty()) {
+            std::vector<size_t> chain;
+            for (size_t v = t; v != INVALID_VERTEX; v = estado.getParent(v)) chain.push_back(v);
+            std::reverse(chain.begin(), chain.end());
+
+            res.best.path.clear();
+            res.best.costs.clear();
+            res.best.total_cost = 0;
+            for (size_t i = 0; i < chain.size(); ++i) {
+                res.best.path.push_back(g.getVertexPorIndice(chain[i]).id);
+                if (i == 0) continue;
+
+                // parents keep the arc they were reached by, but g of the parent may have improved since
+                const Distance arc = g.getArcCost(chain[i - 1], chain[i]);
+                res.best.costs.push_back(arc);
+                res.best.total_cost += arc;
+            }
+            it.cost = res.best.total_cost;
+        }
+        res.iterations.push_back(it);
+
+        if (it.bound <= 1.0) {
+            res.optimal = true;
+            break;
+        }
+
+        epsilon = std::max(1.0, std::min(epsilon - step, it.bound));
+        stamp++;
+        rekey(g, goal_vertex, epsilon);
+    }
+
+    for (auto& it : res.iterations) {
+        it.cost_ratio = static_cast<double>(it.cost) / static_cast<double>(res.best.total_cost);
+    }
+
+    res.best.expansion_count = total_expansions;
+    res.best.elapsed = seconds();
+    return res;
+}
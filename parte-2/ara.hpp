@@ -0,0 +1,64 @@
+// ara.hpp
+#ifndef ARA_HPP
+#define ARA_HPP
+
+#include "tipos.hpp"
+#include "grafo.hpp"
+#include "estado.hpp"
+#include "algoritmo.hpp"
+
+#include <cstdint>
+#include <vector>
+
+struct IteracionARA {
+    double epsilon = 1.0;        // inflation of h used in this iteration
+    double bound = 1.0;          // proven: cost <= bound * optimal
+    Distance cost = INFINITY_DIST;
+    size_t expansions = 0;       // expansions of this iteration only
+    double elapsed = 0.0;        // seconds since the search started
+    double cost_ratio = 0.0;     // cost / best cost found overall (set when the search ends)
+};
+
+struct SolucionARA {
+    SolucionAStar best;          // best path found; expansion_count and elapsed are totals
+    std::vector<IteracionARA> iterations;
+    bool optimal = false;        // an iteration proved bound 1 before the deadline
+};
+
+// Anytime Repairing A* (Likhachev et al.): a sequence of weighted A* searches
+// with a decreasing epsilon that reuse g-values, OPEN and the INCONS list of the
+// previous iteration instead of starting again. Stops at the optimum or at the deadline.
+class AraStar {
+private:
+    struct QItem {
+        VertexID v; // internal index
+        Distance key;
+        Distance g;
+        bool operator>(const QItem& o) const {
+            if (key != o.key) return key > o.key;
+            return g < o.g; // ties: deeper first
+        }
+    };
+
+    EstadoBusqueda estado;
+    std::vector<Distance> h_cache;           // haversine to the goal, INFINITY_DIST = not computed
+    std::vector<std::uint32_t> closed_iter;  // == stamp => closed in the current iteration
+    std::vector<unsigned char> in_incons;
+    std::vector<VertexID> incons;
+    std::vector<QItem> open;
+    std::uint32_t stamp = 0;
+
+    void prepare(const Grafo& g);
+    Distance heuristic(const Grafo& g, size_t v, const Vertex& goal);
+    bool isStale(const QItem& item) const;
+    double currentBound(const Grafo& g, const Vertex& goal, Distance goal_cost);
+    void rekey(const Grafo& g, const Vertex& goal, double epsilon);
+
+public:
+    AraStar() = default;
+
+    // epsilon0 >= 1 (checked by the caller)
+    SolucionARA solve(const Grafo& g, VertexID start, VertexID goal, double epsilon0, double deadline_seconds);
+};
+
+#endif // ARA_HPP
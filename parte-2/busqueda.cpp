@@ -0,0 +1,20 @@
+// busqueda.cpp
+#include "busqueda.hpp"
+
+void BusquedaDensa::init(size_t num_vertices) {
+    estado.init(num_vertices);
+    heap.clear();
+}
+
+void BusquedaDensa::start(size_t num_vertices, size_t source) {
+    // the labels are only reallocated when the graph size changes
+    if (estado.size() != num_vertices) {
+        estado.init(num_vertices);
+    } else {
+        estado.reset();
+    }
+    heap.clear();
+
+    estado.update(source, INVALID_VERTEX, 0);
+    heap.push_back({static_cast<VertexID>(source), 0});
+}
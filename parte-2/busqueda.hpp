@@ -0,0 +1,71 @@
+// busqueda.hpp
+#ifndef BUSQUEDA_HPP
+#define BUSQUEDA_HPP
+
+#include "tipos.hpp"
+#include "estado.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+// Dense Dijkstra over EstadoBusqueda, driven one settled vertex at a time so that
+// every caller keeps its own stopping rule and bookkeeping:
+//
+//     busqueda.start(source);
+//     for (size_t u; (u = busqueda.settleNext()) != INVALID_VERTEX;) {
+//         ... g.forEachAdyacente(u, [&](size_t v, Distance c) { busqueda.relax(u, v, c); });
+//     }
+//
+// Outdated heap entries are dropped lazily and each vertex is settled once. The heap and
+// the labels survive between calls, so a stopped search can be resumed (SesionBusqueda).
+class BusquedaDensa {
+private:
+    struct QItem {
+        VertexID v; // internal index
+        Distance g;
+        bool operator>(const QItem& o) const { return g > o.g; }
+    };
+
+    EstadoBusqueda estado;
+    std::vector<QItem> heap; // kept between searches to reuse its storage
+
+public:
+    // Allocates the labels on the calling thread (see EstadoBusqueda)
+    void init(size_t num_vertices);
+
+    // Clears the previous search (reallocating only if the graph size changed) and queues 'source'
+    void start(size_t num_vertices, size_t source);
+
+    // Settles the closest queued vertex and returns it, INVALID_VERTEX once the queue is empty
+    size_t settleNext() {
+        while (!heap.empty()) {
+            std::pop_heap(heap.begin(), heap.end(), std::greater<QItem>());
+            const QItem cur = heap.back();
+            heap.pop_back();
+            if (cur.g != estado.getDist(cur.v) || estado.isSettled(cur.v)) continue;
+
+            estado.settle(cur.v);
+            return cur.v;
+        }
+        return INVALID_VERTEX;
+    }
+
+    // Arc u -> v of 'cost' from the settled vertex u; true if it improved the label of v
+    bool relax(size_t u, size_t v, Distance cost) {
+        const Distance new_g = estado.getDist(u) + cost;
+        if (new_g >= estado.getDist(v)) return false;
+
+        estado.update(v, static_cast<VertexID>(u), new_g);
+        heap.push_back({static_cast<VertexID>(v), new_g});
+        std::push_heap(heap.begin(), heap.end(), std::greater<QItem>());
+        return true;
+    }
+
+    bool isExhausted() const { return heap.empty(); }
+
+    const EstadoBusqueda& getEstado() const { return estado; }
+};
+
+#endif // BUSQUEDA_HPP
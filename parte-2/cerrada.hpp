@@ -4,6 +4,7 @@
 
 #include "tipos.hpp"
 
+#include <cstddef>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
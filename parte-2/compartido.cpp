@@ -0,0 +1,366 @@
+// compartido.cpp
+#include "compartido.hpp"
+
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <new>
+#include <signal.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+constexpr char SEGMENT_MAGIC[8] = {'P', '2', 'G', 'R', 'A', 'F', 'O', '\0'};
+constexpr std::uint32_t SEGMENT_VERSION = 3;
+constexpr std::uint64_t SEGMENT_ALIGN = 2 * 1024 * 1024; // huge page size, also required by hugetlbfs
+constexpr std::uint64_t ARRAY_ALIGN = 64;
+
+static_assert(std::atomic<std::uint32_t>::is_always_lock_free, "ready flag must be lock-free to live in shared memory");
+
+struct Cabecera {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t header_size;
+    std::atomic<std::uint32_t> ready; // 1 once every array has been written
+    std::int32_t creator_pid;
+    std::uint32_t sizeof_vertex;
+    std::uint32_t sizeof_edge;
+    std::uint32_t sizeof_punto;
+    std::uint32_t reserved;
+    SelloMapa stamp;
+    std::uint64_t total_size;
+
+    // element counts and byte offsets (from the start of the segment) of each array
+    std::uint64_t num_vertices, off_vertices;
+    std::uint64_t num_first_out, off_first_out;
+    std::uint64_t num_arcs, off_arcs;
+    std::uint64_t num_ids, off_id_index;
+    std::uint64_t num_id_sorted, off_id_sorted;
+    std::uint64_t num_puntos, off_puntos;
+    std::uint64_t num_componente, off_componente;
+    std::uint64_t num_componentes, off_comp_topo, off_comp_debil, off_comp_size;
+};
+
+bool isFilePath(const std::string& name) {
+    return name.find('/', 1) != std::string::npos;
+}
+
+std::string shmName(const std::string& name) {
+    return name.empty() || name[0] == '/' ? name : "/" + name;
+}
+
+int openSegment(const std::string& name, int flags, mode_t mode = 0644) {
+    return isFilePath(name) ? ::open(name.c_str(), flags, mode) : ::shm_open(shmName(name).c_str(), flags, mode);
+}
+
+// Companion lock file: the creator holds an exclusive flock on it from before the segment
+// exists until 'ready' is set, so a held lock means "being written" and a free one on an
+// unfinished segment means its creator died
+std::string lockName(const std::string& name) {
+    return name + ".lock";
+}
+
+int unlinkSegment(const std::string& name) {
+    return isFilePath(name) ? ::unlink(name.c_str()) : ::shm_unlink(shmName(name).c_str());
+}
+
+std::uint64_t alignUp(std::uint64_t value, std::uint64_t align) {
+    return (value + align - 1) / align * align;
+}
+
+template <typename T>
+std::span<const T> viewAt(const std::uint8_t* base, std::uint64_t off, std::uint64_t count) {
+    return std::span<const T>(reinterpret_cast<const T*>(base + off), count);
+}
+
+bool processAlive(std::int32_t pid) {
+    return pid > 0 && (::kill(pid, 0) == 0 || errno == EPERM);
+}
+
+// Checks everything except 'ready' and the stamp
+bool headerConsistent(const Cabecera& h, std::uint64_t file_size) {
+    if (std::memcmp(h.magic, SEGMENT_MAGIC, sizeof(SEGMENT_MAGIC)) != 0) return false;
+    if (h.version != SEGMENT_VERSION || h.header_size != sizeof(Cabecera)) return false;
+    if (h.sizeof_vertex != sizeof(Vertex) || h.sizeof_edge != sizeof(Edge) ||
+        h.sizeof_punto != sizeof(IndiceEspacial::Punto)) {
+        return false;
+    }
+    if (h.total_size > file_size || h.num_first_out != h.num_vertices + 1) return false;
+    if (h.num_componente != 0 && h.num_componente != h.num_vertices) return false;
+
+    auto fits = [&](std::uint64_t off, std::uint64_t count, std::uint64_t elem) {
+        return off % ARRAY_ALIGN == 0 && off >= sizeof(Cabecera) && count <= h.total_size / elem &&
+               off + count * elem <= h.total_size;
+    };
+    return fits(h.off_vertices, h.num_vertices, sizeof(Vertex)) &&
+           fits(h.off_first_out, h.num_first_out, sizeof(std::uint64_t)) &&
+           fits(h.off_arcs, h.num_arcs, sizeof(Edge)) &&
+           fits(h.off_id_index, h.num_ids, sizeof(VertexID)) &&
+           fits(h.off_id_sorted, h.num_id_sorted, sizeof(EntradaId)) &&
+           fits(h.off_puntos, h.num_puntos, sizeof(IndiceEspacial::Punto)) &&
+           fits(h.off_componente, h.num_componente, sizeof(VertexID)) &&
+           fits(h.off_comp_topo, h.num_componentes, sizeof(std::uint32_t)) &&
+           fits(h.off_comp_debil, h.num_componentes, sizeof(std::uint32_t)) &&
+           fits(h.off_comp_size, h.num_componentes, sizeof(std::uint32_t));
+}
+
+enum class EstadoSegmento { Missing, Valid, Busy, Stale };
+
+// True while some process holds the creation lock of 'name'. Publishers create the lock
+// before the segment, so without a lock file the segment is a leftover (older build, or
+// lock removed): only a live pid in its header still counts, a zeroed header is stale.
+bool creatorAlive(const std::string& name, std::int32_t pid) {
+    int lfd = openSegment(lockName(name), O_RDONLY);
+    if (lfd < 0) return processAlive(pid);
+
+    const bool held = ::flock(lfd, LOCK_SH | LOCK_NB) != 0 && errno == EWOULDBLOCK;
+    ::close(lfd); // also drops our shared lock if we got it
+    return held;
+}
+
+// Looks at an existing segment without attaching to it.
+// 'holding_lock': the caller owns the creation lock, so nobody else can be writing.
+EstadoSegmento inspect(const std::string& name, const SelloMapa& stamp, bool holding_lock) {
+    int fd = openSegment(name, O_RDONLY);
+    if (fd < 0) return EstadoSegmento::Missing;
+
+    struct stat st{};
+    Cabecera h{};
+    const bool has_header = ::fstat(fd, &st) == 0 && static_cast<std::uint64_t>(st.st_size) >= sizeof(Cabecera) &&
+                            ::pread(fd, &h, sizeof(h), 0) == static_cast<ssize_t>(sizeof(h));
+    ::close(fd);
+
+    // the ready flag is written last (release) and read here after the whole header; a torn
+    // read can only make a finished segment look unfinished, never the other way round
+    if (has_header && headerConsistent(h, static_cast<std::uint64_t>(st.st_size)) &&
+        h.ready.load(std::memory_order_acquire) == 1) {
+        return (h.stamp == stamp) ? EstadoSegmento::Valid : EstadoSegmento::Stale;
+    }
+
+    // empty, partial or unfinished: is its creator still at work?
+    if (holding_lock) return EstadoSegmento::Stale;
+    return creatorAlive(name, has_header ? h.creator_pid : 0) ? EstadoSegmento::Busy : EstadoSegmento::Stale;
+}
+}
+
+bool MemoriaCompartida::attach(Grafo& g, const std::string& name, const SelloMapa& stamp, std::string& error) {
+    int fd = openSegment(name, O_RDONLY);
+    if (fd < 0) {
+        error = "segment not found";
+        return false;
+    }
+
+    struct stat st{};
+    if (::fstat(fd, &st) != 0 || static_cast<std::uint64_t>(st.st_size) < sizeof(Cabecera)) {
+        ::close(fd);
+        error = "segment too small";
+        return false;
+    }
+
+    const std::uint64_t size = static_cast<std::uint64_t>(st.st_size);
+    void* addr = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (addr == MAP_FAILED) {
+        error = std::string("mmap failed: ") + std::strerror(errno);
+        return false;
+    }
+
+    std::shared_ptr<const void> mapping(addr, [size](const void* p) { ::munmap(const_cast<void*>(p), size); });
+
+    const auto* h = static_cast<const Cabecera*>(addr);
+    if (!headerConsistent(*h, size)) {
+        error = "incompatible layout or corrupt header";
+        return false;
+    }
+    if (h->ready.load(std::memory_order_acquire) != 1) {
+        error = "segment is still being written";
+        return false;
+    }
+    if (!(h->stamp == stamp)) {
+        error = "segment was built from different .gr/.co files";
+        return false;
+    }
+
+    const auto* base = static_cast<const std::uint8_t*>(addr);
+
+    // the graph drops its private arrays and reads straight from the mapping
+    g.own_vertices.clear();
+    g.own_first_out.clear();
+    g.own_arcs.clear();
+    g.own_id_index.clear();
+    g.own_id_sorted.clear();
+    g.own_componente.clear();
+    g.own_comp_topo.clear();
+    g.own_comp_debil.clear();
+    g.own_comp_size.clear();
+
+    g.vertices = viewAt<Vertex>(base, h->off_vertices, h->num_vertices);
+    g.first_out = viewAt<std::uint64_t>(base, h->off_first_out, h->num_first_out);
+    g.arcs = viewAt<Edge>(base, h->off_arcs, h->num_arcs);
+    g.id_index = viewAt<VertexID>(base, h->off_id_index, h->num_ids);
+    g.id_sorted = viewAt<EntradaId>(base, h->off_id_sorted, h->num_id_sorted);
+    g.indice_espacial.attach(viewAt<IndiceEspacial::Punto>(base, h->off_puntos, h->num_puntos));
+    g.componente = viewAt<VertexID>(base, h->off_componente, h->num_componente);
+    g.comp_topo = viewAt<std::uint32_t>(base, h->off_comp_topo, h->num_componentes);
+    g.comp_debil = viewAt<std::uint32_t>(base, h->off_comp_debil, h->num_componentes);
+    g.comp_size = viewAt<std::uint32_t>(base, h->off_comp_size, h->num_componentes);
+    g.mapping = std::move(mapping);
+    g.inversa = std::make_unique<Grafo::Inversa>();
+
+    return true;
+}
+
+bool MemoriaCompartida::publish(const Grafo& g, const std::string& name, const SelloMapa& stamp, std::string& error) {
+    switch (inspect(name, stamp, false)) {
+        case EstadoSegmento::Valid:
+            return true; // someone already published this map
+        case EstadoSegmento::Busy:
+            error = "segment is unfinished and its creator is still running";
+            return false;
+        case EstadoSegmento::Stale:
+        case EstadoSegmento::Missing:
+            break;
+    }
+
+    // the creation lock is taken before the segment exists and released once it is ready
+    int lock_fd = openSegment(lockName(name), O_CREAT | O_RDWR);
+    if (lock_fd < 0) {
+        error = std::string("cannot open lock: ") + std::strerror(errno);
+        return false;
+    }
+    if (::flock(lock_fd, LOCK_EX | LOCK_NB) != 0) {
+        ::close(lock_fd);
+        error = "another process is publishing this segment";
+        return false;
+    }
+
+    // under the lock: someone may have finished in the meantime, or left a dead segment behind
+    switch (inspect(name, stamp, true)) {
+        case EstadoSegmento::Valid:
+            ::close(lock_fd);
+            return true;
+        case EstadoSegmento::Stale:
+            unlinkSegment(name);
+            break;
+        default:
+            break;
+    }
+
+    // O_EXCL: only one process wins the creation race
+    int fd = openSegment(name, O_CREAT | O_EXCL | O_RDWR);
+    if (fd < 0) {
+        error = std::string("cannot create segment: ") + std::strerror(errno);
+        ::close(lock_fd);
+        return false;
+    }
+
+    // an unfinished header with our pid goes in before the segment is sized. hugetlbfs
+    // files cannot be written with pwrite; there the lock file alone tells that we are alive.
+    Cabecera pending{};
+    std::memcpy(pending.magic, SEGMENT_MAGIC, sizeof(SEGMENT_MAGIC));
+    pending.creator_pid = static_cast<std::int32_t>(::getpid());
+    [[maybe_unused]] ssize_t written = ::pwrite(fd, &pending, sizeof(pending), 0);
+
+    auto points = g.indice_espacial.getNodes();
+
+    Cabecera layout{};
+    std::uint64_t off = alignUp(sizeof(Cabecera), ARRAY_ALIGN);
+    auto place = [&](std::uint64_t& field_off, std::uint64_t& field_num, std::uint64_t count, std::uint64_t elem) {
+        field_off = off;
+        field_num = count;
+        off = alignUp(off + count * elem, ARRAY_ALIGN);
+    };
+    place(layout.off_vertices, layout.num_vertices, g.vertices.size(), sizeof(Vertex));
+    place(layout.off_first_out, layout.num_first_out, g.first_out.size(), sizeof(std::uint64_t));
+    place(layout.off_arcs, layout.num_arcs, g.arcs.size(), sizeof(Edge));
+    place(layout.off_id_index, layout.num_ids, g.id_index.size(), sizeof(VertexID));
+    place(layout.off_id_sorted, layout.num_id_sorted, g.id_sorted.size(), sizeof(EntradaId));
+    place(layout.off_puntos, layout.num_puntos, points.size(), sizeof(IndiceEspacial::Punto));
+    place(layout.off_componente, layout.num_componente, g.componente.size(), sizeof(VertexID));
+    place(layout.off_comp_topo, layout.num_componentes, g.comp_topo.size(), sizeof(std::uint32_t));
+    place(layout.off_comp_debil, layout.num_componentes, g.comp_debil.size(), sizeof(std::uint32_t));
+    place(layout.off_comp_size, layout.num_componentes, g.comp_size.size(), sizeof(std::uint32_t));
+    const std::uint64_t total = alignUp(off, SEGMENT_ALIGN);
+
+    if (::ftruncate(fd, static_cast<off_t>(total)) != 0) {
+        error = std::string("cannot size segment: ") + std::strerror(errno);
+        ::close(fd);
+        unlinkSegment(name);
+        ::close(lock_fd);
+        return false;
+    }
+
+    void* addr = ::mmap(nullptr, total, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (addr == MAP_FAILED) {
+        error = std::string("mmap failed: ") + std::strerror(errno);
+        unlinkSegment(name);
+        ::close(lock_fd);
+        return false;
+    }
+#ifdef MADV_HUGEPAGE
+    ::madvise(addr, total, MADV_HUGEPAGE);
+#endif
+
+    auto* base = static_cast<std::uint8_t*>(addr);
+    auto* h = new (addr) Cabecera{};
+    h->ready.store(0, std::memory_order_relaxed);
+    h->creator_pid = static_cast<std::int32_t>(::getpid());
+
+    auto copy = [&](std::uint64_t dst_off, auto span) {
+        if (!span.empty()) std::memcpy(base + dst_off, span.data(), span.size_bytes());
+    };
+    copy(layout.off_vertices, g.vertices);
+    copy(layout.off_first_out, g.first_out);
+    copy(layout.off_arcs, g.arcs);
+    copy(layout.off_id_index, g.id_index);
+    copy(layout.off_id_sorted, g.id_sorted);
+    copy(layout.off_puntos, points);
+    copy(layout.off_componente, g.componente);
+    copy(layout.off_comp_topo, g.comp_topo);
+    copy(layout.off_comp_debil, g.comp_debil);
+    copy(layout.off_comp_size, g.comp_size);
+
+    std::memcpy(h->magic, SEGMENT_MAGIC, sizeof(SEGMENT_MAGIC));
+    h->version = SEGMENT_VERSION;
+    h->header_size = sizeof(Cabecera);
+    h->sizeof_vertex = sizeof(Vertex);
+    h->sizeof_edge = sizeof(Edge);
+    h->sizeof_punto = sizeof(IndiceEspacial::Punto);
+    h->stamp = stamp;
+    h->total_size = total;
+    h->num_vertices = layout.num_vertices;
+    h->off_vertices = layout.off_vertices;
+    h->num_first_out = layout.num_first_out;
+    h->off_first_out = layout.off_first_out;
+    h->num_arcs = layout.num_arcs;
+    h->off_arcs = layout.off_arcs;
+    h->num_ids = layout.num_ids;
+    h->off_id_index = layout.off_id_index;
+    h->num_id_sorted = layout.num_id_sorted;
+    h->off_id_sorted = layout.off_id_sorted;
+    h->num_puntos = layout.num_puntos;
+    h->off_puntos = layout.off_puntos;
+    h->num_componente = layout.num_componente;
+    h->off_componente = layout.off_componente;
+    h->num_componentes = layout.num_componentes;
+    h->off_comp_topo = layout.off_comp_topo;
+    h->off_comp_debil = layout.off_comp_debil;
+    h->off_comp_size = layout.off_comp_size;
+
+    // readers only trust the segment after this store
+    h->ready.store(1, std::memory_order_release);
+
+    ::munmap(addr, total);
+    ::close(lock_fd);
+    return true;
+}
+
+bool MemoriaCompartida::remove(const std::string& name) {
+    unlinkSegment(lockName(name));
+    return unlinkSegment(name) == 0;
+}
@@ -0,0 +1,36 @@
+// compartido.hpp
+#ifndef COMPARTIDO_HPP
+#define COMPARTIDO_HPP
+
+#include "grafo.hpp"
+
+#include <string>
+
+// Publishes the immutable arrays of a Grafo (vertices, arc offsets, arcs,
+// id map and spatial index) into a named segment so other parte2 processes can
+// map them read-only instead of parsing the map again.
+//
+// 'name' is either a POSIX shared-memory name ("/parte2-USA") or, if it contains
+// a '/' after the first character, a regular file path; a file on a hugetlbfs
+// mount (e.g. /dev/hugepages/parte2-USA) gives a hugepage-backed segment.
+//
+// The segment header records a layout version, the struct sizes and the
+// SelloMapa of the .gr/.co files; attach() refuses anything that does not match.
+// A 'ready' flag is set only after every array is written. The creator holds an
+// flock on a companion "NAME.lock" from before the segment exists until it is ready,
+// so a half-written segment is "busy" while that lock is held and stale once the
+// creator is gone (whatever size it reached).
+class MemoriaCompartida {
+public:
+    // Maps the segment into 'g'. Returns false (and a reason) if it is missing, incomplete or stale.
+    static bool attach(Grafo& g, const std::string& name, const SelloMapa& stamp, std::string& error);
+
+    // Creates the segment from 'g' (a loaded, private graph). An up-to-date segment is left as is,
+    // a stale or abandoned one is replaced.
+    static bool publish(const Grafo& g, const std::string& name, const SelloMapa& stamp, std::string& error);
+
+    // Removes the name; processes that already attached keep their mapping until they exit.
+    static bool remove(const std::string& name);
+};
+
+#endif // COMPARTIDO_HPP
@@ -0,0 +1,261 @@
+// componentes.cpp
+#include "componentes.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <barrier>
+#include <chrono>
+#include <numeric>
+#include <thread>
+
+namespace {
+constexpr VertexID UNASSIGNED = INVALID_VERTEX;
+
+// Level-synchronous BFS from 'pivot' over the unassigned vertices; marks the reached ones.
+// 'neighbors(u, f)' calls f(v) for every neighbor of u in the direction of the search.
+template <typename Neighbors>
+void parallelReach(size_t pivot, const VectorGrafo<VertexID>& component,
+                   std::vector<std::atomic<unsigned char>>& mark, unsigned threads, Neighbors&& neighbors) {
+    std::vector<VertexID> frontier{static_cast<VertexID>(pivot)};
+    std::vector<std::vector<VertexID>> next(threads);
+    bool done = false;
+    mark[pivot].store(1, std::memory_order_relaxed);
+
+    // the last thread to arrive joins the per-thread frontiers into the next level
+    auto on_level = [&]() noexcept {
+        frontier.clear();
+        for (auto& local : next) {
+            frontier.insert(frontier.end(), local.begin(), local.end());
+            local.clear();
+        }
+        done = frontier.empty();
+    };
+    std::barrier sync(static_cast<std::ptrdiff_t>(threads), on_level);
+
+    auto work = [&](unsigned id) {
+        while (!done) {
+            const size_t chunk = (frontier.size() + threads - 1) / threads;
+            const size_t begin = std::min(frontier.size(), id * chunk);
+            const size_t end = std::min(frontier.size(), begin + chunk);
+            for (size_t i = begin; i < end; ++i) {
+                neighbors(frontier[i], [&](VertexID v) {
+                    if (component[v] != UNASSIGNED) return;
+                    if (mark[v].load(std::memory_order_relaxed) == 0 &&
+                        mark[v].exchange(1, std::memory_order_relaxed) == 0) {
+                        next[id].push_back(v);
+                    }
+                });
+            }
+            sync.arrive_and_wait();
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (unsigned id = 1; id < threads; ++id) pool.emplace_back(work, id);
+    work(0);
+    for (auto& th : pool) th.join();
+}
+}
+
+ComponentesFuertes Componentes::compute(std::span<const std::uint64_t> first_out, std::span<const Edge> arcs,
+                                        unsigned threads) {
+    auto t0 = std::chrono::high_resolution_clock::now();
+
+    ComponentesFuertes res;
+    const size_t n = first_out.empty() ? 0 : first_out.size() - 1;
+    res.component.assign(n, UNASSIGNED);
+    if (n == 0) return res;
+    threads = std::max(1u, threads);
+
+    auto& component = res.component;
+    VertexID next_id = 0;
+
+    // reverse CSR: the tails of the arcs entering v are tails[first_in[v] .. first_in[v + 1])
+    std::vector<std::uint64_t> first_in(n + 1, 0);
+    for (const auto& e : arcs) first_in[e.target_index + 1]++;
+    for (size_t i = 1; i <= n; ++i) first_in[i] += first_in[i - 1];
+    std::vector<VertexID> tails(arcs.size());
+    {
+        std::vector<std::uint64_t> next(first_in.begin(), first_in.end() - 1);
+        for (size_t u = 0; u < n; ++u) {
+            for (std::uint64_t a = first_out[u]; a < first_out[u + 1]; ++a) {
+                tails[next[arcs[a].target_index]++] = static_cast<VertexID>(u);
+            }
+        }
+    }
+
+    auto forOut = [&](size_t u, auto&& f) {
+        for (std::uint64_t a = first_out[u]; a < first_out[u + 1]; ++a) f(arcs[a].target_index);
+    };
+    auto forIn = [&](size_t u, auto&& f) {
+        for (std::uint64_t a = first_in[u]; a < first_in[u + 1]; ++a) f(tails[a]);
+    };
+
+    // 1) Trimming: a vertex without incoming or outgoing arcs (self-loops aside) is an SCC on its own,
+    //    and removing it may expose more of them (dead-end roads, one-way entries)
+    std::vector<std::uint32_t> in_deg(n, 0), out_deg(n, 0);
+    for (size_t u = 0; u < n; ++u) {
+        forOut(u, [&](VertexID v) {
+            if (v == u) return;
+            out_deg[u]++;
+            in_deg[v]++;
+        });
+    }
+
+    std::vector<VertexID> queue;
+    for (size_t u = 0; u < n; ++u) {
+        if (in_deg[u] == 0 || out_deg[u] == 0) {
+            component[u] = next_id++;
+            queue.push_back(static_cast<VertexID>(u));
+        }
+    }
+    for (size_t head = 0; head < queue.size(); ++head) {
+        const VertexID u = queue[head];
+        auto drop = [&](VertexID v, std::uint32_t& deg) {
+            if (v == u || component[v] != UNASSIGNED) return;
+            if (--deg == 0) {
+                component[v] = next_id++;
+                queue.push_back(v);
+            }
+        };
+        forOut(u, [&](VertexID v) { drop(v, in_deg[v]); });
+        forIn(u, [&](VertexID v) { drop(v, out_deg[v]); });
+    }
+    res.informe.trimmed = queue.size();
+
+    // 2) Forward-backward from the vertex with the largest in*out degree: on road maps this is the giant SCC
+    size_t pivot = n;
+    std::uint64_t best = 0;
+    for (size_t u = 0; u < n; ++u) {
+        if (component[u] != UNASSIGNED) continue;
+        const std::uint64_t score = static_cast<std::uint64_t>(in_deg[u] + 1) * (out_deg[u] + 1);
+        if (pivot == n || score > best) {
+            pivot = u;
+            best = score;
+        }
+    }
+
+    if (pivot != n) {
+        std::vector<std::atomic<unsigned char>> fw(n), bw(n);
+        parallelReach(pivot, component, fw, threads, forOut);
+        parallelReach(pivot, component, bw, threads, forIn);
+
+        const VertexID giant = next_id++;
+        for (size_t u = 0; u < n; ++u) {
+            if (fw[u].load(std::memory_order_relaxed) && bw[u].load(std::memory_order_relaxed)) component[u] = giant;
+        }
+    }
+
+    // 3) Iterative Tarjan over the rest (small components around the giant one)
+    std::vector<VertexID> low(n, 0), order(n, UNASSIGNED);
+    std::vector<VertexID> stack;
+    std::vector<std::pair<VertexID, std::uint64_t>> call; // (vertex, next arc to look at)
+    std::vector<unsigned char> on_stack(n, 0);
+    VertexID counter = 0;
+
+    for (size_t root = 0; root < n; ++root) {
+        if (component[root] != UNASSIGNED || order[root] != UNASSIGNED) continue;
+
+        call.push_back({static_cast<VertexID>(root), first_out[root]});
+        order[root] = low[root] = counter++;
+        stack.push_back(static_cast<VertexID>(root));
+        on_stack[root] = 1;
+
+        while (!call.empty()) {
+            auto& [u, arc] = call.back();
+            if (arc < first_out[u + 1]) {
+                const VertexID v = arcs[arc++].target_index;
+                if (component[v] != UNASSIGNED) continue;
+                if (order[v] == UNASSIGNED) {
+                    order[v] = low[v] = counter++;
+                    stack.push_back(v);
+                    on_stack[v] = 1;
+                    call.push_back({v, first_out[v]});
+                } else if (on_stack[v]) {
+                    low[u] = std::min(low[u], order[v]);
+                }
+                continue;
+            }
+
+            // u is finished: close its component if it is a root, then return to the caller
+            const VertexID done = u;
+            call.pop_back();
+            if (low[done] == order[done]) {
+                const VertexID id = next_id++;
+                VertexID w;
+                do {
+                    w = stack.back();
+                    stack.pop_back();
+                    on_stack[w] = 0;
+                    component[w] = id;
+                } while (w != done);
+            }
+            if (!call.empty()) {
+                const VertexID parent = call.back().first;
+                low[parent] = std::min(low[parent], low[done]);
+            }
+        }
+    }
+
+    // 4) Condensation: topological order (Kahn) and weak components (union-find)
+    const size_t c = next_id;
+    res.size.assign(c, 0);
+    for (size_t u = 0; u < n; ++u) res.size[component[u]]++;
+
+    std::vector<std::uint64_t> first_dag(c + 1, 0);
+    std::vector<std::uint32_t> dag_in(c, 0);
+    for (size_t u = 0; u < n; ++u) {
+        forOut(u, [&](VertexID v) {
+            if (component[u] == component[v]) return;
+            first_dag[component[u] + 1]++;
+            dag_in[component[v]]++;
+        });
+    }
+    for (size_t i = 1; i <= c; ++i) first_dag[i] += first_dag[i - 1];
+    std::vector<VertexID> dag(first_dag[c]);
+    std::vector<std::uint64_t> fill(first_dag.begin(), first_dag.end() - 1);
+
+    std::vector<std::uint32_t> parent(c);
+    std::iota(parent.begin(), parent.end(), 0u);
+    auto find = [&](std::uint32_t x) {
+        while (parent[x] != x) x = parent[x] = parent[parent[x]];
+        return x;
+    };
+
+    for (size_t u = 0; u < n; ++u) {
+        forOut(u, [&](VertexID v) {
+            const VertexID cu = component[u], cv = component[v];
+            if (cu == cv) return;
+            dag[fill[cu]++] = cv;
+            parent[find(cu)] = find(cv);
+        });
+    }
+
+    res.topo.assign(c, 0);
+    std::vector<VertexID> ready;
+    for (size_t x = 0; x < c; ++x) {
+        if (dag_in[x] == 0) ready.push_back(static_cast<VertexID>(x));
+    }
+    std::uint32_t position = 0;
+    for (size_t head = 0; head < ready.size(); ++head) {
+        const VertexID x = ready[head];
+        res.topo[x] = position++;
+        for (std::uint64_t a = first_dag[x]; a < first_dag[x + 1]; ++a) {
+            if (--dag_in[dag[a]] == 0) ready.push_back(dag[a]);
+        }
+    }
+
+    // weak ids renumbered densely in order of first appearance
+    res.weak.assign(c, 0);
+    std::vector<std::uint32_t> dense(c, UNASSIGNED);
+    std::uint32_t weak_count = 0;
+    for (size_t x = 0; x < c; ++x) {
+        const std::uint32_t r = find(static_cast<std::uint32_t>(x));
+        if (dense[r] == UNASSIGNED) dense[r] = weak_count++;
+        res.weak[x] = dense[r];
+    }
+
+    auto t1 = std::chrono::high_resolution_clock::now();
+    res.informe.elapsed = std::chrono::duration_cast<std::chrono::duration<double>>(t1 - t0).count();
+    return res;
+}
@@ -0,0 +1,42 @@
+// componentes.hpp
+#ifndef COMPONENTES_HPP
+#define COMPONENTES_HPP
+
+#include "tipos.hpp"
+#include "memoria.hpp"
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// What compute() reports besides the arrays
+struct InformeComponentes {
+    size_t trimmed = 0;   // vertices settled by trimming (in- or out-degree 0)
+    double elapsed = 0.0; // seconds
+};
+
+struct ComponentesFuertes {
+    VectorGrafo<VertexID> component;   // per vertex: strongly connected component id
+    std::vector<std::uint32_t> topo;   // per component: position in a topological order of the condensation
+    std::vector<std::uint32_t> weak;   // per component: weakly connected component id
+    std::vector<std::uint32_t> size;   // per component: number of vertices
+
+    InformeComponentes informe;
+};
+
+// Strongly connected components of the CSR graph (Multistep scheme):
+//  1) trimming of vertices without incoming or outgoing arcs,
+//  2) forward-backward reachability from a high-degree pivot, each one a
+//     level-synchronous BFS split across threads (this finds the giant SCC),
+//  3) iterative Tarjan on whatever is left.
+// The condensation is then ordered topologically, which allows rejecting
+// queries whose goal lies "before" the start, and split into weak components.
+// The backward steps use a temporary reverse adjacency (tail index per arc, 4 bytes)
+// that is freed on return, so the graph does not keep one just for this pass.
+class Componentes {
+public:
+    static ComponentesFuertes compute(std::span<const std::uint64_t> first_out, std::span<const Edge> arcs,
+                                      unsigned threads);
+};
+
+#endif // COMPONENTES_HPP
@@ -0,0 +1,136 @@
+// comprimido.cpp
+#include "comprimido.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace {
+// appends 'value' with the minimum number of bytes (1..4) and returns that length
+unsigned putValue(std::vector<std::uint8_t>& out, std::uint32_t value) {
+    unsigned len = 1;
+    while (len < 4 && (value >> (8 * len)) != 0) len++;
+    for (unsigned b = 0; b < len; ++b) out.push_back(static_cast<std::uint8_t>(value >> (8 * b)));
+    return len;
+}
+}
+
+void GrafoComprimido::setCost(size_t arc, Distance cost) {
+    size_t bit = arc * cost_width;
+    size_t word = bit >> 6;
+    unsigned offset = bit & 63;
+    const std::uint64_t mask = cost_width == 64 ? ~std::uint64_t{0} : (std::uint64_t{1} << cost_width) - 1;
+
+    cost_bits[word] = (cost_bits[word] & ~(mask << offset)) | (cost << offset);
+    if (offset + cost_width > 64) {
+        cost_bits[word + 1] = (cost_bits[word + 1] & ~(mask >> (64 - offset))) | (cost >> (64 - offset));
+    }
+}
+
+void GrafoComprimido::loadGraph(std::string_view gr_file, std::string_view co_file) {
+    vertices.clear();
+    id_index.clear();
+    id_sorted.clear();
+    edge_count = 0;
+
+    // 1) coordinates (.co), with the same reader and id map as Grafo
+    Grafo::readCoordinates(co_file, [&](VertexID id, Coordinate lon, Coordinate lat) {
+        vertices.push_back(Vertex{id, lat, lon});
+    });
+    Grafo::buildIdIndex(vertices, id_index, id_sorted);
+
+    const size_t n = vertices.size();
+    auto index_of = [&](VertexID id) { return Grafo::findIndice(id_index, id_sorted, id); };
+
+    // 2) first pass over the .gr: out-degree of each vertex and the largest cost
+    first_arc.assign(n + 1, 0);
+    Distance max_cost = 0;
+    Grafo::readArcs(gr_file, [&](VertexID u, VertexID v, Distance cost) {
+        VertexID iu = index_of(u);
+        if (iu == INVALID_VERTEX || index_of(v) == INVALID_VERTEX) return;
+        first_arc[iu + 1]++;
+        max_cost = std::max(max_cost, cost);
+    });
+
+    std::uint64_t total = 0;
+    for (size_t v = 1; v <= n; ++v) {
+        total += first_arc[v];
+        if (total > std::numeric_limits<std::uint32_t>::max()) {
+            throw std::runtime_error("Too many arcs for the compressed layout");
+        }
+        first_arc[v] = static_cast<std::uint32_t>(total);
+    }
+    edge_count = total;
+
+    cost_width = std::max(1u, static_cast<unsigned>(std::bit_width(max_cost)));
+    cost_bits.assign((total * cost_width + 63) / 64 + 1, 0);
+
+    // 3) second pass: each arc goes to the next free slot of its source, the target as a
+    //    plain index for now and the cost straight into its packed slot
+    std::vector<std::uint32_t> targets(total);
+    std::vector<std::uint32_t> next(first_arc.begin(), first_arc.end() - 1);
+    Grafo::readArcs(gr_file, [&](VertexID u, VertexID v, Distance cost) {
+        VertexID iu = index_of(u);
+        VertexID iv = index_of(v);
+        if (iu == INVALID_VERTEX || iv == INVALID_VERTEX) return;
+        if (next[iu] == first_arc[iu + 1]) {
+            throw std::runtime_error("Graph file changed while loading: " + std::string(gr_file));
+        }
+        std::uint32_t slot = next[iu]++;
+        targets[slot] = static_cast<std::uint32_t>(iv);
+        setCost(slot, cost);
+    });
+
+    // 4) per vertex: sort its arcs by target (costs follow), then control bytes and delta bytes
+    byte_offset.assign(n, 0);
+    target_bytes.clear();
+
+    std::vector<std::pair<std::uint32_t, Distance>> block;
+    std::vector<std::uint8_t> data;
+    for (size_t v = 0; v < n; ++v) {
+        if (target_bytes.size() > std::numeric_limits<std::uint32_t>::max()) {
+            throw std::runtime_error("Compressed adjacency exceeds 4 GB");
+        }
+        byte_offset[v] = static_cast<std::uint32_t>(target_bytes.size());
+
+        const std::uint32_t first = first_arc[v];
+        const std::uint32_t degree = first_arc[v + 1] - first;
+
+        block.clear();
+        for (std::uint32_t i = 0; i < degree; ++i) block.emplace_back(targets[first + i], getCost(first + i));
+        std::sort(block.begin(), block.end());
+
+        size_t ctrl_pos = target_bytes.size();
+        target_bytes.resize(ctrl_pos + (degree + 3) / 4, 0);
+        data.clear();
+
+        std::uint32_t prev = static_cast<std::uint32_t>(v);
+        for (std::uint32_t k = 0; k < degree; ++k) {
+            const std::uint32_t target = block[k].first;
+            std::uint32_t value;
+            if (k == 0) {
+                auto delta = static_cast<std::int32_t>(target - prev);
+                value = (static_cast<std::uint32_t>(delta) << 1) ^ static_cast<std::uint32_t>(delta >> 31);
+            } else {
+                value = target - prev;
+            }
+            prev = target;
+
+            unsigned len = putValue(data, value);
+            target_bytes[ctrl_pos + k / 4] |= static_cast<std::uint8_t>((len - 1) << ((k % 4) * 2));
+            setCost(first + k, block[k].second);
+        }
+        target_bytes.insert(target_bytes.end(), data.begin(), data.end());
+    }
+    target_bytes.resize(target_bytes.size() + 3, 0); // padding for the 4-byte loads
+
+    target_bytes.shrink_to_fit();
+}
+
+size_t GrafoComprimido::getAdjacencyBytes() const {
+    return first_arc.capacity() * sizeof(std::uint32_t) + byte_offset.capacity() * sizeof(std::uint32_t) +
+           target_bytes.capacity() + cost_bits.capacity() * sizeof(std::uint64_t);
+}
@@ -0,0 +1,111 @@
+// comprimido.hpp
+#ifndef COMPRIMIDO_HPP
+#define COMPRIMIDO_HPP
+
+#include "grafo.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <vector>
+
+// Compressed adjacency for memory-constrained hosts.
+//
+// Arcs of each vertex are sorted by target and the targets are stored as
+// deltas (the first one zigzag-encoded relative to the source index, the rest
+// relative to the previous target) in the group-varint layout of stream-VByte:
+// one control byte holds the byte lengths (1..4) of four values, followed by
+// their data bytes. Costs are bit-packed with the width of the largest cost.
+//
+// loadGraph() reads the .gr twice (degrees and largest cost, then the arcs) so the
+// only uncompressed buffer is one 4-byte target per arc, never a full arc list.
+//
+// It exposes the same dense accessors and forEachAdyacente() as Grafo, so the
+// index-based searches (Rango, Algoritmo, SesionBusqueda) run unchanged over either layout.
+class GrafoComprimido {
+private:
+    VectorGrafo<Vertex> vertices;
+
+    // id -> index map, built like Grafo's (direct table, or sorted pairs for sparse ids)
+    VectorGrafo<VertexID> id_index;
+    VectorGrafo<EntradaId> id_sorted;
+
+    // arcs of v are [first_arc[v], first_arc[v + 1]); their targets start at target_bytes[byte_offset[v]]
+    std::vector<std::uint32_t> first_arc;
+    std::vector<std::uint32_t> byte_offset;
+    std::vector<std::uint8_t> target_bytes;
+    std::vector<std::uint64_t> cost_bits;
+    unsigned cost_width = 0;
+
+    size_t edge_count = 0;
+
+    Distance getCost(size_t arc) const {
+        size_t bit = arc * cost_width;
+        size_t word = bit >> 6;
+        unsigned offset = bit & 63;
+
+        std::uint64_t value = cost_bits[word] >> offset;
+        if (offset + cost_width > 64) value |= cost_bits[word + 1] << (64 - offset);
+        return cost_width == 64 ? value : value & ((std::uint64_t{1} << cost_width) - 1);
+    }
+
+    void setCost(size_t arc, Distance cost);
+
+public:
+    GrafoComprimido() = default;
+
+    void loadGraph(std::string_view gr_file, std::string_view co_file);
+
+    bool hasVertex(VertexID vertex) const {
+        return Grafo::findIndice(id_index, id_sorted, vertex) != INVALID_VERTEX;
+    }
+
+    size_t getIndice(VertexID vertex) const {
+        VertexID index = Grafo::findIndice(id_index, id_sorted, vertex);
+        if (index == INVALID_VERTEX) throw std::out_of_range("Unknown vertex id");
+        return index;
+    }
+    const Vertex& getVertexPorIndice(size_t index) const { return vertices[index]; }
+
+    // Decodes the arcs of 'index' on the fly: f(target_index, cost)
+    template <typename F>
+    void forEachAdyacente(size_t index, F&& f) const {
+        const std::uint32_t first = first_arc[index];
+        const std::uint32_t degree = first_arc[index + 1] - first;
+
+        const std::uint8_t* ctrl = target_bytes.data() + byte_offset[index];
+        const std::uint8_t* data = ctrl + (degree + 3) / 4;
+
+        std::uint32_t prev = static_cast<std::uint32_t>(index);
+        for (std::uint32_t i = 0; i < degree; ++i) {
+            unsigned len = ((ctrl[i >> 2] >> ((i & 3) * 2)) & 3) + 1;
+
+            // the buffer is padded, so reading 4 bytes is always safe
+            std::uint32_t value;
+            std::memcpy(&value, data, sizeof(value));
+            if (len < 4) value &= (std::uint32_t{1} << (8 * len)) - 1;
+            data += len;
+
+            std::uint32_t target;
+            if (i == 0) {
+                target = prev + ((value >> 1) ^ (0u - (value & 1))); // zigzag: wraps like a signed delta
+            } else {
+                target = prev + value;
+            }
+            prev = target;
+
+            f(static_cast<VertexID>(target), getCost(first + i));
+        }
+    }
+
+    // No component index is kept here: every pair may be reachable, the search decides
+    bool isUnreachablePorIndice(size_t, size_t) const { return false; }
+
+    size_t getNumVertices() const { return vertices.size(); }
+    size_t getNumEdges() const { return edge_count; }
+
+    // Bytes used by the adjacency structure (offsets + encoded targets + packed costs)
+    size_t getAdjacencyBytes() const;
+};
+
+#endif // COMPRIMIDO_HPP
@@ -0,0 +1,126 @@
+// espacial.cpp
+#include "espacial.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <queue>
+#include <utility>
+
+namespace {
+constexpr double DEG_TO_RAD = 3.14159265358979323846 / 180.0;
+constexpr double COORD_SCALE = 1e-6; // coordinates are degrees x 10^6
+
+double lonScale(Coordinate latitude) {
+    return std::cos(static_cast<double>(latitude) * COORD_SCALE * DEG_TO_RAD);
+}
+
+double projected2(Coordinate latitude, Coordinate longitude, Coordinate p_latitude, Coordinate p_longitude,
+                  double lon_scale) {
+    double dlat = static_cast<double>(latitude - p_latitude);
+    double dlon = static_cast<double>(longitude - p_longitude) * lon_scale;
+    return dlat * dlat + dlon * dlon;
+}
+}
+
+double IndiceEspacial::distance2(Coordinate latitude, Coordinate longitude, Coordinate p_latitude,
+                                 Coordinate p_longitude) {
+    return projected2(latitude, longitude, p_latitude, p_longitude, lonScale(latitude));
+}
+
+void IndiceEspacial::build(std::span<const Vertex> vertices) {
+    own_nodes.clear();
+    own_nodes.reserve(vertices.size());
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        own_nodes.push_back({vertices[i].latitude, vertices[i].longitude, static_cast<VertexID>(i)});
+    }
+    buildRange(0, own_nodes.size(), 0);
+    nodes = own_nodes;
+}
+
+void IndiceEspacial::buildRange(size_t lo, size_t hi, unsigned depth) {
+    if (hi - lo <= 1) return;
+
+    size_t mid = (lo + hi) / 2;
+    // we place the median of the current axis in the middle; smaller ones go left
+    if (depth % 2 == 0) {
+        std::nth_element(own_nodes.begin() + lo, own_nodes.begin() + mid, own_nodes.begin() + hi,
+                         [](const Punto& a, const Punto& b) { return a.latitude < b.latitude; });
+    } else {
+        std::nth_element(own_nodes.begin() + lo, own_nodes.begin() + mid, own_nodes.begin() + hi,
+                         [](const Punto& a, const Punto& b) { return a.longitude < b.longitude; });
+    }
+
+    buildRange(lo, mid, depth + 1);
+    buildRange(mid + 1, hi, depth + 1);
+}
+
+VertexID IndiceEspacial::nearest(Coordinate latitude, Coordinate longitude) const {
+    std::vector<VertexID> best = kNearest(latitude, longitude, 1);
+    return best.empty() ? INVALID_VERTEX : best.front();
+}
+
+std::vector<VertexID> IndiceEspacial::kNearest(Coordinate latitude, Coordinate longitude, size_t k) const {
+    std::vector<VertexID> result;
+    if (nodes.empty() || k == 0) return result;
+
+    const double lon_scale = lonScale(latitude);
+
+    // max-heap with the k best candidates found so far (squared projected distance)
+    std::priority_queue<std::pair<double, VertexID>> best;
+
+    auto bound = [&]() {
+        return best.size() < k ? std::numeric_limits<double>::infinity() : best.top().first;
+    };
+
+    // depth-first descent: the far side is only visited when the splitting
+    // plane is closer than the current k-th candidate
+    auto visit = [&](auto&& self, size_t lo, size_t hi, unsigned depth) -> void {
+        if (lo >= hi) return;
+
+        size_t mid = (lo + hi) / 2;
+        const Punto& p = nodes[mid];
+
+        double dlat = static_cast<double>(latitude - p.latitude);
+        double dlon = static_cast<double>(longitude - p.longitude) * lon_scale;
+        double d2 = projected2(latitude, longitude, p.latitude, p.longitude, lon_scale);
+
+        if (d2 < bound()) {
+            best.push({d2, p.index});
+            if (best.size() > k) best.pop();
+        }
+
+        double diff = (depth % 2 == 0) ? dlat : dlon;
+        if (diff < 0) {
+            self(self, lo, mid, depth + 1);
+            if (diff * diff < bound()) self(self, mid + 1, hi, depth + 1);
+        } else {
+            self(self, mid + 1, hi, depth + 1);
+            if (diff * diff < bound()) self(self, lo, mid, depth + 1);
+        }
+    };
+    visit(visit, 0, nodes.size(), 0);
+
+    result.resize(best.size());
+    for (size_t i = result.size(); i-- > 0;) {
+        result[i] = best.top().second;
+        best.pop();
+    }
+    return result;
+}
+
+void IndiceEspacial::save(std::ostream& out) const {
+    std::uint64_t n = nodes.size();
+    out.write(reinterpret_cast<const char*>(&n), sizeof(n));
+    out.write(reinterpret_cast<const char*>(nodes.data()), static_cast<std::streamsize>(n * sizeof(Punto)));
+}
+
+bool IndiceEspacial::load(std::istream& in) {
+    std::uint64_t n = 0;
+    if (!in.read(reinterpret_cast<char*>(&n), sizeof(n))) return false;
+
+    own_nodes.resize(n);
+    nodes = own_nodes;
+    return static_cast<bool>(in.read(reinterpret_cast<char*>(own_nodes.data()), static_cast<std::streamsize>(n * sizeof(Punto))));
+}
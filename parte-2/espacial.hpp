@@ -0,0 +1,63 @@
+// espacial.hpp
+#ifndef ESPACIAL_HPP
+#define ESPACIAL_HPP
+
+#include "tipos.hpp"
+
+#include <cstddef>
+#include <istream>
+#include <ostream>
+#include <span>
+#include <vector>
+
+// Static 2-d tree over the .co coordinates stored as one flat array:
+// the node of the range [lo, hi) is nodes[(lo + hi) / 2], its children are the
+// two halves, and the split axis alternates latitude/longitude with the depth.
+// Distances use a local equirectangular projection (longitude scaled by the
+// cosine of the query latitude), which is exact enough for snapping.
+class IndiceEspacial {
+public:
+    struct Punto {
+        Coordinate latitude{};
+        Coordinate longitude{};
+        VertexID index{}; // internal vertex index in Grafo
+    };
+
+private:
+    std::vector<Punto> own_nodes;
+    std::span<const Punto> nodes; // own_nodes or an external (shared) array
+
+    void buildRange(size_t lo, size_t hi, unsigned depth);
+
+public:
+    IndiceEspacial() = default;
+    IndiceEspacial(const IndiceEspacial&) = delete;
+    IndiceEspacial& operator=(const IndiceEspacial&) = delete;
+    IndiceEspacial(IndiceEspacial&&) = default;
+    IndiceEspacial& operator=(IndiceEspacial&&) = default;
+
+    void build(std::span<const Vertex> vertices);
+
+    // Uses an already built array (e.g. from shared memory) without copying it
+    void attach(std::span<const Punto> external) {
+        own_nodes.clear();
+        nodes = external;
+    }
+    std::span<const Punto> getNodes() const { return nodes; }
+
+    // Internal index of the closest vertex (INVALID_VERTEX if the index is empty)
+    VertexID nearest(Coordinate latitude, Coordinate longitude) const;
+
+    // Internal indices of the k closest vertices, closest first
+    std::vector<VertexID> kNearest(Coordinate latitude, Coordinate longitude, size_t k) const;
+
+    // The squared projected distance the queries rank by, from the query point (latitude, longitude)
+    static double distance2(Coordinate latitude, Coordinate longitude, Coordinate p_latitude, Coordinate p_longitude);
+
+    size_t size() const { return nodes.size(); }
+
+    void save(std::ostream& out) const;
+    bool load(std::istream& in);
+};
+
+#endif // ESPACIAL_HPP
@@ -0,0 +1,19 @@
+// estado.cpp
+#include "estado.hpp"
+
+void EstadoBusqueda::init(size_t num_vertices) {
+    dist.assign(num_vertices, INFINITY_DIST);
+    parent.assign(num_vertices, INVALID_VERTEX);
+    settled.assign(num_vertices, 0);
+    touched.clear();
+}
+
+void EstadoBusqueda::reset() {
+    // we only undo what the last search wrote
+    for (VertexID v : touched) {
+        dist[v] = INFINITY_DIST;
+        parent[v] = INVALID_VERTEX;
+        settled[v] = 0;
+    }
+    touched.clear();
+}
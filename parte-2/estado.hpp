@@ -0,0 +1,45 @@
+// estado.hpp
+#ifndef ESTADO_HPP
+#define ESTADO_HPP
+
+#include "tipos.hpp"
+#include "memoria.hpp"
+
+#include <cstddef>
+#include <vector>
+
+// Dense search labels indexed by the internal vertex index [0..N-1].
+// reset() only clears the entries touched by the previous search, so the
+// same instance can be reused for many searches without paying O(N) each time.
+// The arrays are allocated (and first touched) by the thread that calls init(),
+// which keeps them on that thread's NUMA node.
+class EstadoBusqueda {
+private:
+    VectorEstado<Distance> dist;
+    VectorEstado<VertexID> parent; // internal index of the parent (INVALID_VERTEX for the root)
+    VectorEstado<unsigned char> settled;
+    std::vector<VertexID> touched;
+
+public:
+    void init(size_t num_vertices);
+    void reset();
+
+    size_t size() const { return dist.size(); }
+
+    Distance getDist(size_t v) const { return dist[v]; }
+    VertexID getParent(size_t v) const { return parent[v]; }
+
+    void update(size_t v, VertexID parent_index, Distance d) {
+        if (dist[v] == INFINITY_DIST) touched.push_back(static_cast<VertexID>(v));
+        dist[v] = d;
+        parent[v] = parent_index;
+    }
+
+    // settled flags, for searches that stop and resume (SesionBusqueda)
+    bool isSettled(size_t v) const { return settled[v] != 0; }
+    void settle(size_t v) { settled[v] = 1; }
+
+    const std::vector<VertexID>& getTouched() const { return touched; }
+};
+
+#endif // ESTADO_HPP
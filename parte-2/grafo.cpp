@@ -1,29 +1,115 @@
 // grafo.cpp
 #include "grafo.hpp"
 
+#include <algorithm>
+#include <filesystem>
 #include <fstream>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <thread>
+
+SelloMapa SelloMapa::fromFiles(std::string_view gr_file, std::string_view co_file) {
+    namespace fs = std::filesystem;
+    SelloMapa st;
+    std::error_code ec;
+    st.gr_size = fs::file_size(gr_file, ec);
+    st.gr_mtime = fs::last_write_time(gr_file, ec).time_since_epoch().count();
+    st.co_size = fs::file_size(co_file, ec);
+    st.co_mtime = fs::last_write_time(co_file, ec).time_since_epoch().count();
+    return st;
+}
+
+void Grafo::refreshViews() {
+    mapping.reset();
+    inversa = std::make_unique<Inversa>();
+    vertices = own_vertices;
+    first_out = own_first_out;
+    arcs = own_arcs;
+    id_index = own_id_index;
+    id_sorted = own_id_sorted;
+    componente = own_componente;
+    comp_topo = own_comp_topo;
+    comp_debil = own_comp_debil;
+    comp_size = own_comp_size;
+}
+
+void Grafo::adoptComponentes(ComponentesFuertes&& scc) {
+    own_componente = std::move(scc.component);
+    own_comp_topo = std::move(scc.topo);
+    own_comp_debil = std::move(scc.weak);
+    own_comp_size = std::move(scc.size);
+    componente = own_componente;
+    comp_topo = own_comp_topo;
+    comp_debil = own_comp_debil;
+    comp_size = own_comp_size;
+}
+
+InformeComponentes Grafo::buildComponentes(unsigned threads) {
+    ComponentesFuertes scc = Componentes::compute(first_out, arcs, threads);
+    const InformeComponentes informe = scc.informe;
+    adoptComponentes(std::move(scc));
+    return informe;
+}
+
+const AdyacenciaInversa& Grafo::getInversa() const {
+    std::call_once(inversa->built, [this]() {
+        const size_t n = vertices.size();
+        AdyacenciaInversa& inv = inversa->data;
+
+        inv.first_in.assign(n + 1, 0);
+        for (const auto& e : arcs) inv.first_in[e.target_index + 1]++;
+        for (size_t i = 1; i <= n; ++i) inv.first_in[i] += inv.first_in[i - 1];
+
+        // counting sort by head, so the incoming arcs of each vertex keep the order of their tails
+        inv.arcs.resize(arcs.size());
+        std::vector<std::uint64_t> next(inv.first_in.begin(), inv.first_in.end() - 1);
+        for (size_t u = 0; u < n; ++u) {
+            for (std::uint64_t a = first_out[u]; a < first_out[u + 1]; ++a) {
+                inv.arcs[next[arcs[a].target_index]++] = Edge{vertices[u].id, static_cast<VertexID>(u), arcs[a].cost};
+            }
+        }
+    });
+    return inversa->data;
+}
+
+size_t Grafo::getLargestComponentSize() const {
+    return comp_size.empty() ? 0 : *std::max_element(comp_size.begin(), comp_size.end());
+}
+
+size_t Grafo::getNumComponentesDebiles() const {
+    return comp_debil.empty() ? 0 : *std::max_element(comp_debil.begin(), comp_debil.end()) + 1;
+}
 
 void Grafo::loadGraph(std::string_view gr_file, std::string_view co_file) {
     // Reset state (in case reused)
-    adjacency_list.clear();
-    vertices.clear();
-    vertex_index_map.clear();
-    edge_count = 0;
+    own_vertices.clear();
+    own_first_out.clear();
+    own_arcs.clear();
+    own_id_index.clear();
+    own_id_sorted.clear();
+    own_componente.clear();
+    own_comp_topo.clear();
+    own_comp_debil.clear();
+    own_comp_size.clear();
 
     // 1) Load coordinates (.co) first [file:1]
     parseCoordinatesFile(co_file);
 
-    // 2) Allocate adjacency list with contiguous indices
-    adjacency_list.assign(vertices.size(), {});
-
-    // 3) Load arcs (.gr) [file:1]
+    // 2) Load arcs (.gr) into the flat arc array [file:1]
     parseGraphFile(gr_file);
+
+    refreshViews();
+
+    // 3) Spatial index for coordinate queries
+    indice_espacial.build(vertices);
+
+    // 4) Component index, so unreachable queries are rejected before searching
+    buildComponentes(std::thread::hardware_concurrency());
 }
 
-void Grafo::parseCoordinatesFile(std::string_view filename) {
+void Grafo::readCoordinates(std::string_view filename,
+                            const std::function<void(VertexID, Coordinate, Coordinate)>& f) {
     std::ifstream file{std::string(filename)};
     if (!file.is_open()) {
         throw std::runtime_error("Cannot open coordinates file: " + std::string(filename));
@@ -40,27 +126,14 @@ void Grafo::parseCoordinatesFile(std::string_view filename) {
         Coordinate lon;
         Coordinate lat;
 
-        if (!(iss >> prefix >> id >> lon >> lat)) {
+        if (!(iss >> prefix >> id >> lon >> lat) || id == INVALID_VERTEX) {
             continue; // ignore malformed lines
         }
-
-        // Avoid duplicates if present
-        if (vertex_index_map.find(id) != vertex_index_map.end()) {
-            continue;
-        }
-
-        size_t idx = vertices.size();
-        vertex_index_map[id] = idx;
-
-        Vertex v;
-        v.id = id;
-        v.longitude = lon;
-        v.latitude = lat;
-        vertices.push_back(v);
+        f(id, lon, lat);
     }
 }
 
-void Grafo::parseGraphFile(std::string_view filename) {
+void Grafo::readArcs(std::string_view filename, const std::function<void(VertexID, VertexID, Distance)>& f) {
     std::ifstream file{std::string(filename)};
     if (!file.is_open()) {
         throw std::runtime_error("Cannot open graph file: " + std::string(filename));
@@ -79,16 +152,209 @@ void Grafo::parseGraphFile(std::string_view filename) {
         if (!(iss >> prefix >> u >> v >> cost)) {
             continue; // ignore malformed lines
         }
+        f(u, v, cost);
+    }
+}
+
+void Grafo::parseCoordinatesFile(std::string_view filename) {
+    readCoordinates(filename, [&](VertexID id, Coordinate lon, Coordinate lat) {
+        Vertex v;
+        v.id = id;
+        v.longitude = lon;
+        v.latitude = lat;
+        own_vertices.push_back(v);
+    });
+    buildIdIndex(own_vertices, own_id_index, own_id_sorted);
 
-        auto it_u = vertex_index_map.find(u);
-        auto it_v = vertex_index_map.find(v);
+    // the .gr parser resolves ids through these views before refreshViews()
+    id_index = own_id_index;
+    id_sorted = own_id_sorted;
+}
+
+void Grafo::buildIdIndex(VectorGrafo<Vertex>& vertices, VectorGrafo<VertexID>& dense,
+                         VectorGrafo<EntradaId>& sorted) {
+    // (id, index) pairs in file order; the stable sort keeps the first line of a repeated id
+    VectorGrafo<EntradaId> entries(vertices.size());
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        entries[i] = EntradaId{vertices[i].id, static_cast<VertexID>(i)};
+    }
+    std::stable_sort(entries.begin(), entries.end(),
+                     [](const EntradaId& a, const EntradaId& b) { return a.id < b.id; });
+    entries.erase(std::unique(entries.begin(), entries.end(),
+                              [](const EntradaId& a, const EntradaId& b) { return a.id == b.id; }),
+                  entries.end());
+
+    // Avoid duplicates if present: keep the surviving vertices, in file order
+    if (entries.size() != vertices.size()) {
+        std::vector<unsigned char> keep(vertices.size(), 0);
+        for (const auto& e : entries) keep[e.index] = 1;
+        std::vector<VertexID> moved(vertices.size(), INVALID_VERTEX);
+        size_t n = 0;
+        for (size_t i = 0; i < vertices.size(); ++i) {
+            if (keep[i]) {
+                moved[i] = static_cast<VertexID>(n);
+                vertices[n++] = vertices[i];
+            }
+        }
+        vertices.resize(n);
+        for (auto& e : entries) e.index = moved[e.index];
+    }
+
+    // DIMACS ids are 1..N, so the id -> index map is usually a direct table; a file with
+    // sparse or huge ids would make that table far larger than the graph, so past 4 N we
+    // keep the sorted pairs instead
+    const size_t n = entries.size();
+    const size_t max_id = entries.empty() ? 0 : entries.back().id;
+    if (max_id <= 4 * n) {
+        dense.assign(max_id + 1, INVALID_VERTEX);
+        for (const auto& e : entries) dense[e.id] = e.index;
+        sorted.clear();
+    } else {
+        dense.clear();
+        sorted = std::move(entries);
+    }
+}
+
+void Grafo::parseGraphFile(std::string_view filename) {
+    // arcs in file order, grouped by source afterwards (counting sort keeps that order)
+    std::vector<VertexID> sources;
+    std::vector<Edge> edges;
+
+    readArcs(filename, [&](VertexID u, VertexID v, Distance cost) {
+        VertexID iu = lookupIndice(u);
+        VertexID iv = lookupIndice(v);
 
         // Some datasets might contain arcs referencing nodes not present in .co; ignore them safely
-        if (it_u == vertex_index_map.end() || it_v == vertex_index_map.end()) {
-            continue;
+        if (iu == INVALID_VERTEX || iv == INVALID_VERTEX) {
+            return;
         }
 
-        adjacency_list[it_u->second].push_back(Edge{v, cost});
-        edge_count++;
+        sources.push_back(iu);
+        edges.push_back(Edge{v, iv, cost});
+    });
+
+    own_first_out.assign(own_vertices.size() + 1, 0);
+    for (VertexID u : sources) own_first_out[u + 1]++;
+    for (size_t i = 1; i < own_first_out.size(); ++i) own_first_out[i] += own_first_out[i - 1];
+
+    own_arcs.resize(edges.size());
+    std::vector<std::uint64_t> next(own_first_out.begin(), own_first_out.end() - 1);
+    for (size_t i = 0; i < edges.size(); ++i) {
+        own_arcs[next[sources[i]]++] = edges[i];
+    }
+}
+
+size_t Grafo::getAdjacencyBytes() const {
+    return first_out.size_bytes() + arcs.size_bytes();
+}
+
+VertexID Grafo::getNearestVertex(Coordinate latitude, Coordinate longitude) const {
+    VertexID index = indice_espacial.nearest(latitude, longitude);
+    return index == INVALID_VERTEX ? INVALID_VERTEX : vertices[index].id;
+}
+
+std::vector<VertexID> Grafo::getNearestVertices(Coordinate latitude, Coordinate longitude, size_t k) const {
+    std::vector<VertexID> ids;
+    for (VertexID index : indice_espacial.kNearest(latitude, longitude, k)) {
+        ids.push_back(vertices[index].id);
     }
+    return ids;
+}
+
+// ------------------------------------------------------------
+// Binary cache
+// ------------------------------------------------------------
+namespace {
+constexpr char CACHE_MAGIC[4] = {'G', 'R', 'C', '1'};
+constexpr std::uint32_t CACHE_VERSION = 4;
+}
+
+// Layout (native byte order):
+//   "GRC1" | u32 version | SelloMapa
+//   | u64 N | Vertex[N] | u64 first_out[N + 1] | u64 M | Edge[M]
+//   | u64 id_index size | VertexID id_index[] | u64 id_sorted size | EntradaId id_sorted[]
+//   | spatial index
+//   | u64 C | u32 topo[C] | u32 weak[C] | u32 size[C] | VertexID component[N]
+bool Grafo::saveCache(std::string_view cache_file, std::string_view gr_file, std::string_view co_file) const {
+    std::ofstream out{std::string(cache_file), std::ios::binary};
+    if (!out) return false;
+
+    auto put = [&](const auto& value) { out.write(reinterpret_cast<const char*>(&value), sizeof(value)); };
+    auto put_span = [&](auto span) {
+        out.write(reinterpret_cast<const char*>(span.data()), static_cast<std::streamsize>(span.size_bytes()));
+    };
+
+    out.write(CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    put(CACHE_VERSION);
+    put(SelloMapa::fromFiles(gr_file, co_file));
+
+    put(static_cast<std::uint64_t>(vertices.size()));
+    put_span(vertices);
+    put_span(first_out);
+    put(static_cast<std::uint64_t>(arcs.size()));
+    put_span(arcs);
+    put(static_cast<std::uint64_t>(id_index.size()));
+    put_span(id_index);
+    put(static_cast<std::uint64_t>(id_sorted.size()));
+    put_span(id_sorted);
+
+    indice_espacial.save(out);
+
+    put(static_cast<std::uint64_t>(comp_size.size()));
+    put_span(comp_topo);
+    put_span(comp_debil);
+    put_span(comp_size);
+    put_span(componente);
+    return static_cast<bool>(out);
+}
+
+bool Grafo::loadCache(std::string_view cache_file, std::string_view gr_file, std::string_view co_file) {
+    std::ifstream in{std::string(cache_file), std::ios::binary};
+    if (!in) return false;
+
+    auto get = [&](auto& value) { return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(value))); };
+    auto get_vector = [&](auto& vec, std::uint64_t n) {
+        vec.resize(n);
+        return static_cast<bool>(in.read(reinterpret_cast<char*>(vec.data()),
+                                         static_cast<std::streamsize>(n * sizeof(vec[0]))));
+    };
+
+    char magic[4];
+    std::uint32_t version = 0;
+    SelloMapa stamp;
+    if (!in.read(magic, sizeof(magic)) || !std::equal(magic, magic + 4, CACHE_MAGIC)) return false;
+    if (!get(version) || version != CACHE_VERSION) return false;
+    if (!get(stamp) || !(stamp == SelloMapa::fromFiles(gr_file, co_file))) return false;
+
+    VectorGrafo<Vertex> new_vertices;
+    VectorGrafo<std::uint64_t> new_first_out;
+    VectorGrafo<Edge> new_arcs;
+    VectorGrafo<VertexID> new_id_index;
+    VectorGrafo<EntradaId> new_id_sorted;
+    std::uint64_t n = 0, m = 0, ids = 0, sorted = 0;
+
+    if (!get(n) || !get_vector(new_vertices, n) || !get_vector(new_first_out, n + 1)) return false;
+    if (!get(m) || !get_vector(new_arcs, m)) return false;
+    if (!get(ids) || !get_vector(new_id_index, ids)) return false;
+    if (!get(sorted) || !get_vector(new_id_sorted, sorted)) return false;
+
+    IndiceEspacial new_indice;
+    if (!new_indice.load(in)) return false;
+
+    ComponentesFuertes scc;
+    std::uint64_t c = 0;
+    if (!get(c) || !get_vector(scc.topo, c) || !get_vector(scc.weak, c) || !get_vector(scc.size, c)) return false;
+    if (!get_vector(scc.component, n)) return false;
+
+    // everything read correctly: we replace the current state
+    own_vertices = std::move(new_vertices);
+    own_first_out = std::move(new_first_out);
+    own_arcs = std::move(new_arcs);
+    own_id_index = std::move(new_id_index);
+    own_id_sorted = std::move(new_id_sorted);
+    refreshViews();
+    indice_espacial = std::move(new_indice);
+    adoptComponentes(std::move(scc));
+
+    return true;
 }
@@ -3,45 +3,223 @@
 #define GRAFO_HPP
 
 #include "tipos.hpp"
+#include "espacial.hpp"
+#include "componentes.hpp"
 
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <stdexcept>
 #include <string_view>
-#include <unordered_map>
 #include <vector>
 
+// Size + modification time of the .gr/.co files a graph was built from.
+// Stored in the binary cache and in the shared-memory segment to detect stale copies.
+struct SelloMapa {
+    std::uint64_t gr_size = 0;
+    std::int64_t gr_mtime = 0;
+    std::uint64_t co_size = 0;
+    std::int64_t co_mtime = 0;
+
+    static SelloMapa fromFiles(std::string_view gr_file, std::string_view co_file);
+
+    bool operator==(const SelloMapa&) const = default;
+};
+
+// Sparse id map entry, kept sorted by id
+struct EntradaId {
+    VertexID id{};
+    VertexID index{};
+};
+
+// Reverse adjacency: the arcs entering v are arcs[first_in[v] .. first_in[v + 1]),
+// with target_index = internal index of the tail (and target its DIMACS id)
+struct AdyacenciaInversa {
+    std::vector<std::uint64_t> first_in;
+    std::vector<Edge> arcs;
+};
+
 class Grafo {
 private:
-    // Internal storage (indexed by [0..N-1])
-    std::vector<std::vector<Edge>> adjacency_list;
-    std::vector<Vertex> vertices;
+    friend class MemoriaCompartida;
+
+    // Owned storage (indexed by [0..N-1]); empty when the graph is attached to shared memory.
+    // Arcs are kept in one flat array: the arcs of v are arcs[first_out[v] .. first_out[v + 1]).
+    // The big arrays go through MemoriaGrande (huge pages, NUMA interleaving).
+    VectorGrafo<Vertex> own_vertices;
+    VectorGrafo<std::uint64_t> own_first_out;
+    VectorGrafo<Edge> own_arcs;
+
+    // Map external VertexID (DIMACS id, 1..N) -> internal index, INVALID_VERTEX if absent.
+    // A direct table while the largest id is at most 4 N; otherwise (sparse or huge ids)
+    // the table stays empty and sorted (id, index) pairs are binary searched.
+    VectorGrafo<VertexID> own_id_index;
+    VectorGrafo<EntradaId> own_id_sorted;
+
+    // Strongly connected components: id per vertex, and per component its position in a
+    // topological order of the condensation, its weak component and its size
+    VectorGrafo<VertexID> own_componente;
+    std::vector<std::uint32_t> own_comp_topo;
+    std::vector<std::uint32_t> own_comp_debil;
+    std::vector<std::uint32_t> own_comp_size;
 
-    // Map external VertexID (DIMACS id) -> internal index
-    std::unordered_map<VertexID, size_t> vertex_index_map;
+    // Read-only views used by every accessor (point to the owned storage or to a mapping)
+    std::span<const Vertex> vertices;
+    std::span<const std::uint64_t> first_out;
+    std::span<const Edge> arcs;
+    std::span<const VertexID> id_index;
+    std::span<const EntradaId> id_sorted;
+    std::span<const VertexID> componente;
+    std::span<const std::uint32_t> comp_topo;
+    std::span<const std::uint32_t> comp_debil;
+    std::span<const std::uint32_t> comp_size;
 
-    size_t edge_count = 0;
+    // Keeps the shared-memory mapping alive while the views point into it
+    std::shared_ptr<const void> mapping;
+
+    // Nearest-vertex lookups over the .co coordinates (built at load time)
+    IndiceEspacial indice_espacial;
+
+    // Reverse adjacency, built on first use by whichever thread asks first
+    struct Inversa {
+        std::once_flag built;
+        AdyacenciaInversa data;
+    };
+    mutable std::unique_ptr<Inversa> inversa = std::make_unique<Inversa>();
+
+    void refreshViews();
+    void adoptComponentes(ComponentesFuertes&& scc);
 
 public:
     Grafo() = default;
     ~Grafo() = default;
 
+    // the views point into the owned vectors, which a move keeps but a copy would not
+    Grafo(const Grafo&) = delete;
+    Grafo& operator=(const Grafo&) = delete;
+    Grafo(Grafo&&) = default;
+    Grafo& operator=(Grafo&&) = default;
+
     void loadGraph(std::string_view gr_file, std::string_view co_file);
 
-    const std::vector<Edge>& getAdyacentes(VertexID vertex) const {
-        return adjacency_list.at(vertex_index_map.at(vertex));
+    // Binary graph cache (adjacency, coordinates, spatial index and components).
+    // loadCache() returns false if the cache is missing or older than the .gr/.co files.
+    bool loadCache(std::string_view cache_file, std::string_view gr_file, std::string_view co_file);
+    bool saveCache(std::string_view cache_file, std::string_view gr_file, std::string_view co_file) const;
+
+    // DIMACS readers, shared with GrafoComprimido: 'f' gets every well-formed line of the file
+    static void readCoordinates(std::string_view filename,
+                                const std::function<void(VertexID, Coordinate, Coordinate)>& f);
+    static void readArcs(std::string_view filename, const std::function<void(VertexID, VertexID, Distance)>& f);
+
+    // Drops repeated ids from 'vertices' (the first line wins) and builds the id -> index map
+    // into 'dense' or 'sorted' (see own_id_index); findIndice() looks an id up in the result
+    static void buildIdIndex(VectorGrafo<Vertex>& vertices, VectorGrafo<VertexID>& dense,
+                             VectorGrafo<EntradaId>& sorted);
+
+    static VertexID findIndice(std::span<const VertexID> dense, std::span<const EntradaId> sorted, VertexID vertex) {
+        if (!sorted.empty()) {
+            auto it = std::lower_bound(sorted.begin(), sorted.end(), vertex,
+                                       [](const EntradaId& e, VertexID id) { return e.id < id; });
+            return it != sorted.end() && it->id == vertex ? it->index : INVALID_VERTEX;
+        }
+        return vertex < dense.size() ? dense[vertex] : INVALID_VERTEX;
+    }
+
+    std::span<const Edge> getAdyacentes(VertexID vertex) const {
+        size_t index = getIndice(vertex);
+        return arcs.subspan(first_out[index], first_out[index + 1] - first_out[index]);
     }
 
     const Vertex& getVertex(VertexID vertex) const {
-        return vertices.at(vertex_index_map.at(vertex));
+        return vertices[getIndice(vertex)];
     }
 
-    bool hasVertex(VertexID vertex) const {
-        return vertex_index_map.find(vertex) != vertex_index_map.end();
+    bool hasVertex(VertexID vertex) const { return lookupIndice(vertex) != INVALID_VERTEX; }
+
+    // Dense access by internal index [0..N-1], used by the array-based searches
+    size_t getIndice(VertexID vertex) const {
+        VertexID index = lookupIndice(vertex);
+        if (index == INVALID_VERTEX) throw std::out_of_range("Unknown vertex id");
+        return index;
     }
 
+    std::span<const Edge> getAdyacentesPorIndice(size_t index) const {
+        return arcs.subspan(first_out[index], first_out[index + 1] - first_out[index]);
+    }
+
+    const Vertex& getVertexPorIndice(size_t index) const { return vertices[index]; }
+
+    // Incoming arcs (backward searches); the first call builds them, later calls are free.
+    // Only the modes that search backward pay for them (the component index has its own).
+    const AdyacenciaInversa& getInversa() const;
+
+    std::span<const Edge> getEntrantesPorIndice(size_t index) const {
+        const AdyacenciaInversa& inv = getInversa();
+        return std::span<const Edge>(inv.arcs).subspan(inv.first_in[index],
+                                                       inv.first_in[index + 1] - inv.first_in[index]);
+    }
+
+    // Neighbor iteration shared with GrafoComprimido: f(target_index, cost)
+    template <typename F>
+    void forEachAdyacente(size_t index, F&& f) const {
+        for (const auto& e : getAdyacentesPorIndice(index)) f(e.target_index, e.cost);
+    }
+
+    // Cheapest arc u -> v by internal index (INFINITY_DIST if there is none), for rebuilding path costs
+    Distance getArcCost(size_t u, size_t v) const {
+        Distance best = INFINITY_DIST;
+        for (const auto& e : getAdyacentesPorIndice(u)) {
+            if (e.target_index == v) best = std::min(best, e.cost);
+        }
+        return best;
+    }
+
+    // O(1) reachability filter. True only when no path start -> goal can exist: different weak
+    // components, or the goal's SCC comes before the start's in the topological order of the
+    // condensation. False means "maybe" (same SCC is always reachable).
+    bool isUnreachablePorIndice(size_t start, size_t goal) const {
+        if (componente.empty()) return false;
+        const VertexID cs = componente[start];
+        const VertexID ct = componente[goal];
+        if (cs == ct) return false;
+        return comp_debil[cs] != comp_debil[ct] || comp_topo[cs] > comp_topo[ct];
+    }
+
+    // Every search checks this before expanding anything, so a pair with no possible path
+    // answers with infinite cost and 0 expansions
+    bool isUnreachable(VertexID start, VertexID goal) const {
+        return isUnreachablePorIndice(getIndice(start), getIndice(goal));
+    }
+
+    // Recomputes the component index with 'threads' workers (loadGraph already does it)
+    InformeComponentes buildComponentes(unsigned threads);
+
+    VertexID getComponente(size_t index) const { return componente[index]; }
+    size_t getNumComponentes() const { return comp_size.size(); }
+    size_t getLargestComponentSize() const;
+    size_t getNumComponentesDebiles() const;
+
+    // Bytes used by the adjacency structure (offsets + arc storage)
+    size_t getAdjacencyBytes() const;
+
+    // Snapping of coordinates (degrees x 10^6) to DIMACS vertex ids
+    VertexID getNearestVertex(Coordinate latitude, Coordinate longitude) const;
+    std::vector<VertexID> getNearestVertices(Coordinate latitude, Coordinate longitude, size_t k) const;
+
+    // True when the arrays live in a shared-memory segment instead of this process
+    bool isShared() const { return mapping != nullptr; }
+
     // Enunciado wants number of vertices processed from .co and arcs from .gr [file:1]
     size_t getNumVertices() const { return vertices.size(); }
-    size_t getNumEdges() const { return edge_count; }
+    size_t getNumEdges() const { return arcs.size(); }
 
 private:
+    VertexID lookupIndice(VertexID vertex) const { return findIndice(id_index, id_sorted, vertex); }
+
     void parseGraphFile(std::string_view filename);
     void parseCoordinatesFile(std::string_view filename);
 };
@@ -1,18 +1,1105 @@
 // main.cpp
 #include "algoritmo.hpp"
+#include "ara.hpp"
+#include "compartido.hpp"
+#include "comprimido.hpp"
 #include "grafo.hpp"
+#include "memoria.hpp"
+#include "paralelo.hpp"
+#include "rango.hpp"
+#include "reducido.hpp"
+#include "sesion.hpp"
+#include "transito.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
 #include <fstream>
+#include <iomanip>
 #include <iostream>
+#include <mutex>
+#include <random>
+#include <sstream>
 #include <string>
+#include <thread>
+#include <vector>
 
 // usage info to know how to run the program
 static void usage() {
     std::cerr << "Uso: ./parte2 START GOAL MAP.gr MAP.co OUT_FILE\n";
     std::cerr << "Ejemplo: ./parte2 1 309 USA-road-d.BAY.gr USA-road-d.BAY.co solucion.txt\n";
+    std::cerr << "     o: ./parte2 --rango DIST MAP.gr MAP.co OUT_FILE SRC [SRC...]\n";
+    std::cerr << "     o: ./parte2 --arbol MAP.gr MAP.co OUT_FILE SRC [SRC...]\n";
+    std::cerr << "        (OUT_FILE terminado en .bin => binario, si no CSV)\n";
+    std::cerr << "     o: ./parte2 --coords LAT1 LON1 LAT2 LON2 MAP.gr MAP.co OUT_FILE [K]   (grados decimales)\n";
+    std::cerr << "     o: ./parte2 --comprimido MAP.gr MAP.co NUM_FUENTES   (memoria vs expansiones/s)\n";
+    std::cerr << "     o: ./parte2 --comprimido-ruta START GOAL MAP.gr MAP.co OUT_FILE [astar|dijkstra]   (solo el grafo comprimido)\n";
+    std::cerr << "     o: ./parte2 --lote PAIRS_FILE MAP.gr MAP.co OUT_FILE [comprimido]   (una pareja START GOAL por linea)\n";
+    std::cerr << "     o: ./parte2 --wastar EPS START GOAL MAP.gr MAP.co OUT_FILE   (coste <= EPS * optimo)\n";
+    std::cerr << "     o: ./parte2 --ara EPS0 PLAZO_SEG START GOAL MAP.gr MAP.co OUT_FILE   (ARA*, anytime)\n";
+    std::cerr << "     o: ./parte2 --reducido START GOAL MAP.gr MAP.co OUT_FILE   (A* sobre el grafo reducido)\n";
+    std::cerr << "     o: ./parte2 --reducir MAP.gr MAP.co NUM_CONSULTAS   (informe de reduccion y aceleracion)\n";
+    std::cerr << "     o: ./parte2 --bidireccional START GOAL MAP.gr MAP.co OUT_FILE   (A* bidireccional, 2 hilos)\n";
+    std::cerr << "     o: ./parte2 --paralelo MAP.gr MAP.co NUM_CONSULTAS   (aceleracion de 1 y 2 hilos frente a A*)\n";
+    std::cerr << "     o: ./parte2 --transito MAP.gr MAP.co NUM_TRANSITO NUM_CONSULTAS   (tabla de nodos de transito)\n";
+    std::cerr << "     o: ./parte2 --componentes MAP.gr MAP.co NUM_FUENTES   (componentes fuertes y alcanzabilidad)\n";
+    std::cerr << "     o: ./parte2 --paginas-comparar MAP.gr MAP.co NUM_FUENTES   (tiempo de arboles por modo de paginas)\n";
+    std::cerr << "     o: ./parte2 --shm-borrar NOMBRE   (elimina un segmento compartido)\n";
+    std::cerr << "Opciones globales (antes del modo):\n";
+    std::cerr << "  --cache CACHE_FILE   usa/crea una cache binaria del mapa\n";
+    std::cerr << "  --shm NOMBRE         se une al mapa publicado en memoria compartida o lo publica\n";
+    std::cerr << "  --paginas MODO       normales | thp (por defecto) | explicitas (MAP_HUGETLB)\n";
+    std::cerr << "  --numa MODO          ninguno (por defecto) | intercalado (grafo repartido, estado local) | local\n";
+}
+
+// path in the required format: v - (cost) - v - (cost) - ... - v
+static void writePath(std::ostream& out, const SolucionAStar& resultado) {
+    if (resultado.path.empty()) return;
+
+    for (size_t i = 0; i < resultado.path.size(); ++i) {
+        if (i) out << " - ";
+        out << resultado.path[i];
+
+        if (i + 1 < resultado.path.size()) {
+            out << " - (" << resultado.costs[i] << ")";
+        }
+    }
+    out << "\n";
+}
+
+// Writes the path to OUT_FILE and prints the report of a single query (default mode)
+template <typename G>
+static int writeRuta(const G& grafo, const SolucionAStar& resultado, const std::string& out_path) {
+    // we write thee path to OUT_FILE in required format: v - cost - v - cost - ... - v
+    std::ofstream out(out_path);
+    if (!out) {
+        std::cerr << "Error: no se puede abrir OUT_FILE: " << out_path << "\n";
+        return 3;
+    }
+
+    writePath(out, resultado);
+    out.close();
+
+    // we print the stats to the console
+    std::cout << grafo.getNumVertices() << "\n"; // 1) number of vertices processed (.co)
+    std::cout << grafo.getNumEdges() << "\n"; // 2) number of arcs processed (.gr)
+    std::cout << resultado.total_cost << "\n"; // 3) optimal cost
+    std::cout << resultado.expansion_count << "\n"; // 4) number of nodes expanded nodes
+	std::cout << std::fixed << std::setprecision(6) << resultado.elapsed << "\n"; // 5)  execution time (seconds)
+
+    return 0;
+}
+
+// pseudo-random vertex ids (fixed seed, so every run and every mode draws the same ones)
+static std::vector<VertexID> randomVertices(const Grafo& grafo, size_t count) {
+    std::mt19937 rng(12345);
+    std::vector<VertexID> ids;
+    for (size_t i = 0; i < count && grafo.getNumVertices() > 0; ++i) {
+        ids.push_back(grafo.getVertexPorIndice(rng() % grafo.getNumVertices()).id);
+    }
+    return ids;
+}
+
+// 'count' pseudo-random (start, goal) queries, from the same sequence as randomVertices()
+static std::vector<std::pair<VertexID, VertexID>> randomPairs(const Grafo& grafo, size_t count) {
+    const std::vector<VertexID> ids = randomVertices(grafo, 2 * count);
+    std::vector<std::pair<VertexID, VertexID>> pairs;
+    for (size_t i = 0; i + 1 < ids.size(); i += 2) pairs.emplace_back(ids[i], ids[i + 1]);
+    return pairs;
+}
+
+// path of the binary graph cache (empty => always parse .gr/.co)
+static std::string cache_path;
+
+// name of the shared-memory segment (empty => private copy only)
+static std::string shm_name;
+
+static void loadGrafo(Grafo& grafo, const std::string& gr_path, const std::string& co_path) {
+    const SelloMapa stamp = SelloMapa::fromFiles(gr_path, co_path);
+    std::string error;
+
+    // fast path: another process already published this map
+    if (!shm_name.empty() && MemoriaCompartida::attach(grafo, shm_name, stamp, error)) return;
+
+    if (cache_path.empty() || !grafo.loadCache(cache_path, gr_path, co_path)) {
+        grafo.loadGraph(gr_path, co_path);
+
+        if (!cache_path.empty() && !grafo.saveCache(cache_path, gr_path, co_path)) {
+            std::cerr << "Aviso: no se puede escribir la cache: " << cache_path << "\n";
+        }
+    }
+
+    if (!shm_name.empty() && !MemoriaCompartida::publish(grafo, shm_name, stamp, error)) {
+        std::cerr << "Aviso: no se puede publicar en memoria compartida (" << error << ")\n";
+    }
+}
+
+// one line for the benchmark output: pages/NUMA mode, blocks, MB mapped, MB on huge pages, NUMA nodes
+static void writeMemoria(std::ostream& out) {
+    const InformeMemoria info = MemoriaGrande::report();
+    out << MemoriaGrande::describe() << " " << info.bloques << " " << std::fixed << std::setprecision(1)
+        << info.bytes / 1048576.0 << " " << info.anon_huge_kb / 1024.0 << " " << info.nodos_numa << "\n";
+}
+
+static bool endsWith(const std::string& s, const std::string& suffix) {
+    return s.size() >= suffix.size() && s.compare(s.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+// --rango / --arbol: bounded range queries or full trees for a batch of sources
+static int runRango(int argc, char* argv[]) {
+    const std::string mode = argv[1];
+    const bool bounded = (mode == "--rango");
+    const int first = bounded ? 3 : 2; // index of MAP.gr
+
+    if (argc < first + 4) {
+        usage();
+        return 1;
+    }
+
+    Distance limit = INFINITY_DIST;
+    std::vector<VertexID> sources;
+    try {
+        if (bounded) limit = static_cast<Distance>(std::stoull(argv[2]));
+        for (int i = first + 3; i < argc; ++i) {
+            sources.push_back(static_cast<VertexID>(std::stoul(argv[i])));
+        }
+    } catch (...) {
+        std::cerr << "Error: DIST y SRC deben ser enteros.\n";
+        return 2;
+    }
+
+    const std::string gr_path  = argv[first];
+    const std::string co_path  = argv[first + 1];
+    const std::string out_path = argv[first + 2];
+
+    Grafo grafo;
+    loadGrafo(grafo, gr_path, co_path);
+
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+
+    auto t0 = std::chrono::high_resolution_clock::now();
+    std::vector<ResultadoRango> results = Rango::solveLote(grafo, sources, limit, threads);
+    auto t1 = std::chrono::high_resolution_clock::now();
+    double elapsed = std::chrono::duration_cast<std::chrono::duration<double>>(t1 - t0).count();
+
+    bool ok = endsWith(out_path, ".bin") ? Rango::writeBinary(out_path, results)
+                                         : Rango::writeCSV(out_path, results);
+    if (!ok) {
+        std::cerr << "Error: no se puede escribir OUT_FILE: " << out_path << "\n";
+        return 3;
+    }
+
+    size_t settled = 0, frontier = 0, expansions = 0;
+    for (const auto& r : results) {
+        settled += r.settled.size();
+        frontier += r.frontier.size();
+        expansions += r.expansion_count;
+    }
+
+    std::cout << grafo.getNumVertices() << "\n"; // 1) number of vertices processed (.co)
+    std::cout << grafo.getNumEdges() << "\n"; // 2) number of arcs processed (.gr)
+    std::cout << settled << "\n"; // 3) settled vertices (all sources)
+    std::cout << frontier << "\n"; // 4) frontier arcs (all sources)
+    std::cout << expansions << "\n"; // 5) number of expanded nodes
+    std::cout << std::fixed << std::setprecision(6) << elapsed << "\n"; // 6) wall time of the batch (seconds)
+    std::cout << threads << "\n"; // 7) threads used
+    writeMemoria(std::cout); // 8) memory placement
+
+    return 0;
+}
+
+// --coords: snap both GPS points to their nearest vertices and solve with A*
+static int runCoords(int argc, char* argv[]) {
+    if (argc != 9 && argc != 10) {
+        usage();
+        return 1;
+    }
+
+    Coordinate coords[4];
+    try {
+        for (int i = 0; i < 4; ++i) {
+            coords[i] = static_cast<Coordinate>(std::llround(std::stod(argv[2 + i]) * 1e6));
+        }
+    } catch (...) {
+        std::cerr << "Error: LAT y LON deben ser numeros.\n";
+        return 2;
+    }
+
+    const std::string gr_path  = argv[6];
+    const std::string co_path  = argv[7];
+    const std::string out_path = argv[8];
+
+    size_t k = 0; // > 0: also list the k nearest candidates of each point
+    if (argc == 10) {
+        try {
+            k = std::stoul(argv[9]);
+        } catch (...) {
+            std::cerr << "Error: K debe ser un entero.\n";
+            return 2;
+        }
+    }
+
+    Grafo grafo;
+    loadGrafo(grafo, gr_path, co_path);
+
+    auto t0 = std::chrono::high_resolution_clock::now();
+    VertexID start = grafo.getNearestVertex(coords[0], coords[1]);
+    VertexID goal  = grafo.getNearestVertex(coords[2], coords[3]);
+    auto t1 = std::chrono::high_resolution_clock::now();
+    double snap_time = std::chrono::duration_cast<std::chrono::duration<double>>(t1 - t0).count();
+
+    Algoritmo algoritmo;
+    SolucionAStar resultado = algoritmo.solveAStar(grafo, start, goal);
+
+    std::ofstream out(out_path);
+    if (!out) {
+        std::cerr << "Error: no se puede abrir OUT_FILE: " << out_path << "\n";
+        return 3;
+    }
+    writePath(out, resultado);
+
+    std::cout << grafo.getNumVertices() << "\n"; // 1) number of vertices processed (.co)
+    std::cout << grafo.getNumEdges() << "\n"; // 2) number of arcs processed (.gr)
+    std::cout << resultado.total_cost << "\n"; // 3) optimal cost
+    std::cout << resultado.expansion_count << "\n"; // 4) number of nodes expanded nodes
+    std::cout << std::fixed << std::setprecision(6) << resultado.elapsed << "\n"; // 5)  execution time (seconds)
+    std::cout << start << "\n"; // 6) snapped start vertex
+    std::cout << goal << "\n"; // 7) snapped goal vertex
+    std::cout << snap_time << "\n"; // 8) snapping time for both points (seconds)
+    if (k == 0) return 0;
+
+    // 9-10) the k nearest vertices of each point, closest first; 11) they match a full scan
+    // (compared by distance, so ties may list different vertices)
+    bool same = true;
+    for (int p = 0; p < 2; ++p) {
+        const Coordinate lat = coords[2 * p];
+        const Coordinate lon = coords[2 * p + 1];
+        auto dist = [&](VertexID id) {
+            const Vertex& v = grafo.getVertex(id);
+            return IndiceEspacial::distance2(lat, lon, v.latitude, v.longitude);
+        };
+
+        const std::vector<VertexID> candidates = grafo.getNearestVertices(lat, lon, k);
+        std::vector<double> scan;
+        for (size_t i = 0; i < grafo.getNumVertices(); ++i) scan.push_back(dist(grafo.getVertexPorIndice(i).id));
+        const size_t expected = std::min(k, scan.size());
+        std::partial_sort(scan.begin(), scan.begin() + expected, scan.end());
+
+        same = same && candidates.size() == expected;
+        for (size_t i = 0; i < candidates.size(); ++i) {
+            std::cout << (i ? " " : "") << candidates[i];
+            same = same && i < expected && dist(candidates[i]) == scan[i];
+        }
+        std::cout << "\n";
+    }
+    std::cout << (same ? "OK" : "ERROR") << "\n";
+
+    return same ? 0 : 4;
+}
+
+// --comprimido: compares the plain and the compressed adjacency on the same full trees
+static int runComprimido(int argc, char* argv[]) {
+    if (argc != 5) {
+        usage();
+        return 1;
+    }
+
+    size_t num_sources = 0;
+    try {
+        num_sources = std::stoul(argv[4]);
+    } catch (...) {
+        std::cerr << "Error: NUM_FUENTES debe ser un entero.\n";
+        return 2;
+    }
+
+    Grafo grafo;
+    loadGrafo(grafo, argv[2], argv[3]);
+
+    GrafoComprimido comprimido;
+    comprimido.loadGraph(argv[2], argv[3]);
+
+    // same pseudo-random sources for both layouts
+    const std::vector<VertexID> sources = randomVertices(grafo, num_sources);
+
+    // runs every tree on one thread and returns expansions per second
+    auto bench = [&](const auto& g, std::vector<ResultadoRango>& out) {
+        Rango rango;
+        size_t expansions = 0;
+        auto t0 = std::chrono::high_resolution_clock::now();
+        for (VertexID s : sources) {
+            out.push_back(rango.solveArbol(g, s));
+            expansions += out.back().expansion_count;
+        }
+        auto t1 = std::chrono::high_resolution_clock::now();
+        double t = std::chrono::duration_cast<std::chrono::duration<double>>(t1 - t0).count();
+        return t > 0 ? expansions / t : 0.0;
+    };
+
+    std::vector<ResultadoRango> plain_res, comp_res;
+    double plain_rate = bench(grafo, plain_res);
+    double comp_rate  = bench(comprimido, comp_res);
+
+    // both layouts must produce the same distances
+    bool same = true;
+    for (size_t i = 0; i < plain_res.size() && same; ++i) {
+        same = plain_res[i].settled.size() == comp_res[i].settled.size();
+        for (size_t j = 0; same && j < plain_res[i].settled.size(); ++j) {
+            same = plain_res[i].settled[j].dist == comp_res[i].settled[j].dist;
+        }
+    }
+
+    const double arcs = static_cast<double>(std::max<size_t>(1, grafo.getNumEdges()));
+
+    std::cout << grafo.getNumVertices() << "\n"; // 1) number of vertices processed (.co)
+    std::cout << grafo.getNumEdges() << "\n"; // 2) number of arcs processed (.gr)
+    std::cout << grafo.getAdjacencyBytes() << "\n"; // 3) adjacency bytes, plain layout
+    std::cout << comprimido.getAdjacencyBytes() << "\n"; // 4) adjacency bytes, compressed layout
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << grafo.getAdjacencyBytes() / arcs << "\n"; // 5) bytes per arc, plain
+    std::cout << comprimido.getAdjacencyBytes() / arcs << "\n"; // 6) bytes per arc, compressed
+    std::cout << plain_rate << "\n"; // 7) expansions/sec, plain
+    std::cout << comp_rate << "\n"; // 8) expansions/sec, compressed
+    std::cout << (same ? "OK" : "DISTINTOS") << "\n"; // 9) both layouts agree on every distance
+
+    return same ? 0 : 4;
+}
+
+// --comprimido-ruta: one A* (or Dijkstra) query answered from the compressed layout alone;
+// the plain adjacency is never built, so the peak memory is that of GrafoComprimido
+static int runComprimidoRuta(int argc, char* argv[]) {
+    if (argc != 7 && argc != 8) {
+        usage();
+        return 1;
+    }
+
+    VertexID start{};
+    VertexID goal{};
+    try {
+        start = static_cast<VertexID>(std::stoul(argv[2]));
+        goal  = static_cast<VertexID>(std::stoul(argv[3]));
+    } catch (...) {
+        std::cerr << "Error: START y GOAL deben ser enteros.\n";
+        return 2;
+    }
+
+    const std::string algorithm = (argc == 8) ? argv[7] : "astar";
+    if (algorithm != "astar" && algorithm != "dijkstra") {
+        std::cerr << "Error: algoritmo desconocido: " << algorithm << "\n";
+        return 2;
+    }
+
+    GrafoComprimido comprimido;
+    comprimido.loadGraph(argv[4], argv[5]);
+
+    Algoritmo algoritmo;
+    SolucionAStar resultado = (algorithm == "dijkstra") ? algoritmo.solveDijkstra(comprimido, start, goal)
+                                                         : algoritmo.solveAStar(comprimido, start, goal);
+
+    return writeRuta(comprimido, resultado, argv[6]);
+}
+
+// --paginas-comparar: the same full trees with the graph and the search state placed in each
+// page mode (the --numa mode is kept), so the effect of huge pages is measured in one run
+static int runPaginas(int argc, char* argv[]) {
+    if (argc != 5) {
+        usage();
+        return 1;
+    }
+
+    size_t num_sources = 0;
+    try {
+        num_sources = std::stoul(argv[4]);
+    } catch (...) {
+        std::cerr << "Error: NUM_FUENTES debe ser un entero.\n";
+        return 2;
+    }
+
+    const ModoNuma numa = MemoriaGrande::getNuma();
+    const ModoPaginas modes[3] = {ModoPaginas::Normal, ModoPaginas::Transparentes, ModoPaginas::Explicitas};
+
+    std::vector<VertexID> sources;
+    std::vector<Distance> reference; // sum of the tree distances per source, from the first mode
+    size_t vertices = 0, arcs = 0;
+    bool same = true;
+
+    std::cout << std::fixed;
+    for (int k = 0; k < 3; ++k) {
+        MemoriaGrande::configure(modes[k], numa);
+
+        // a fresh private graph each time, so its arrays are placed in this mode (never the shm copy)
+        Grafo grafo;
+        if (cache_path.empty() || !grafo.loadCache(cache_path, argv[2], argv[3])) grafo.loadGraph(argv[2], argv[3]);
+        vertices = grafo.getNumVertices();
+        arcs = grafo.getNumEdges();
+
+        if (k == 0) sources = randomVertices(grafo, num_sources);
+
+        Rango rango;
+        size_t expansions = 0;
+        std::vector<Distance> sums;
+        auto t0 = std::chrono::high_resolution_clock::now();
+        for (VertexID s : sources) {
+            ResultadoRango res = rango.solveArbol(grafo, s);
+            expansions += res.expansion_count;
+            Distance sum = 0;
+            for (const auto& r : res.settled) sum += r.dist;
+            sums.push_back(sum);
+        }
+        auto t1 = std::chrono::high_resolution_clock::now();
+        double elapsed = std::chrono::duration_cast<std::chrono::duration<double>>(t1 - t0).count();
+
+        if (k == 0) reference = sums;
+        same = same && sums == reference;
+
+        // 1-3) per mode: mode, blocks, MB mapped, MB on huge pages (transparent, explicit), time, expansions/s
+        const InformeMemoria info = MemoriaGrande::report();
+        std::cout << MemoriaGrande::describe() << " " << info.bloques << " " << std::setprecision(1)
+                  << info.bytes / 1048576.0 << " " << info.anon_huge_kb / 1024.0 << " "
+                  << info.bytes_explicitas / 1048576.0 << " " << std::setprecision(6) << elapsed << " "
+                  << std::setprecision(2) << (elapsed > 0 ? expansions / elapsed : 0.0) << "\n";
+    }
+
+    std::cout << vertices << "\n"; // 4) number of vertices processed (.co)
+    std::cout << arcs << "\n"; // 5) number of arcs processed (.gr)
+    std::cout << sources.size() << "\n"; // 6) trees per mode
+    std::cout << (same ? "OK" : "DISTINTOS") << "\n"; // 7) every mode gives the same trees
+
+    return same ? 0 : 4;
+}
+
+// Answers a --lote batch over either graph layout and prints its report
+template <typename G>
+static int answerLote(const G& grafo, const std::vector<std::pair<VertexID, VertexID>>& pairs,
+                      const std::string& out_path) {
+    // queries sorted by start; each group of equal starts goes to one session
+    std::vector<size_t> order(pairs.size());
+    for (size_t i = 0; i < order.size(); ++i) order[i] = i;
+    std::stable_sort(order.begin(), order.end(),
+                     [&](size_t a, size_t b) { return pairs[a].first < pairs[b].first; });
+
+    std::vector<std::pair<size_t, size_t>> groups; // [begin, end) over 'order'
+    for (size_t i = 0; i < order.size();) {
+        size_t j = i;
+        while (j < order.size() && pairs[order[j]].first == pairs[order[i]].first) j++;
+        groups.emplace_back(i, j);
+        i = j;
+    }
+
+    std::vector<SolucionAStar> results(pairs.size());
+    std::vector<EstadisticasSesion> per_thread;
+    std::mutex stats_mutex;
+    std::atomic<size_t> next{0};
+
+    auto worker = [&]() {
+        SesionBusqueda sesion;
+        for (size_t gi = next++; gi < groups.size(); gi = next++) {
+            for (size_t k = groups[gi].first; k < groups[gi].second; ++k) {
+                size_t q = order[k];
+                results[q] = sesion.query(grafo, pairs[q].first, pairs[q].second);
+            }
+        }
+        std::lock_guard<std::mutex> lock(stats_mutex);
+        per_thread.push_back(sesion.getEstadisticas());
+    };
+
+    unsigned threads = std::max(1u, std::min<unsigned>(std::thread::hardware_concurrency(),
+                                                       static_cast<unsigned>(std::max<size_t>(1, groups.size()))));
+
+    auto t0 = std::chrono::high_resolution_clock::now();
+    std::vector<std::thread> pool;
+    for (unsigned t = 1; t < threads; ++t) pool.emplace_back(worker);
+    worker();
+    for (auto& th : pool) th.join();
+    auto t1 = std::chrono::high_resolution_clock::now();
+    double elapsed = std::chrono::duration_cast<std::chrono::duration<double>>(t1 - t0).count();
+
+    // one line per query, in input order: START GOAL COST EXPANSIONS PATH
+    std::ofstream out(out_path);
+    if (!out) {
+        std::cerr << "Error: no se puede abrir OUT_FILE: " << out_path << "\n";
+        return 3;
+    }
+
+    EstadisticasSesion total;
+    size_t expansions = 0;
+    for (const auto& st : per_thread) {
+        total.queries += st.queries;
+        total.hits += st.hits;
+        total.resumes += st.resumes;
+        total.fresh += st.fresh;
+        total.rejected += st.rejected;
+    }
+    for (size_t q = 0; q < pairs.size(); ++q) {
+        expansions += results[q].expansion_count;
+        out << pairs[q].first << " " << pairs[q].second << " " << results[q].total_cost << " "
+            << results[q].expansion_count << " ";
+        writePath(out, results[q]);
+        if (results[q].path.empty()) out << "\n";
+    }
+
+    const double n = static_cast<double>(std::max<size_t>(1, total.queries));
+
+    std::cout << grafo.getNumVertices() << "\n"; // 1) number of vertices processed (.co)
+    std::cout << grafo.getNumEdges() << "\n"; // 2) number of arcs processed (.gr)
+    std::cout << pairs.size() << "\n"; // 3) number of queries
+    std::cout << groups.size() << "\n"; // 4) distinct sources
+    std::cout << expansions << "\n"; // 5) number of expanded nodes (all queries)
+    std::cout << std::fixed << std::setprecision(6) << elapsed << "\n"; // 6) wall time of the batch (seconds)
+    std::cout << std::setprecision(4) << total.hits / n << "\n"; // 7) hit rate (goal already settled)
+    std::cout << total.resumes / n << "\n"; // 8) resume rate (search continued)
+    std::cout << total.fresh / n << "\n"; // 9) fresh searches rate
+    std::cout << total.rejected / n << "\n"; // 10) rejected rate (unknown id or unreachable); 7-10 add up to 1
+    writeMemoria(std::cout); // 11) memory placement
+
+    return 0;
+}
+
+// --lote: batch of (start, goal) pairs, grouped by start so each group reuses one search tree
+static int runLote(int argc, char* argv[]) {
+    if (argc != 6 && argc != 7) {
+        usage();
+        return 1;
+    }
+
+    const std::string pairs_path = argv[2];
+    const std::string gr_path    = argv[3];
+    const std::string co_path    = argv[4];
+    const std::string out_path   = argv[5];
+
+    const bool compressed = (argc == 7);
+    if (compressed && std::string(argv[6]) != "comprimido") {
+        usage();
+        return 1;
+    }
+
+    // we accept "START GOAL" lines and the CSV of generate_pairs.py (last two fields)
+    std::ifstream in(pairs_path);
+    if (!in) {
+        std::cerr << "Error: no se puede abrir PAIRS_FILE: " << pairs_path << "\n";
+        return 2;
+    }
+
+    std::vector<std::pair<VertexID, VertexID>> pairs;
+    std::string line;
+    while (std::getline(in, line)) {
+        std::replace(line.begin(), line.end(), ',', ' ');
+        std::istringstream iss(line);
+        std::vector<std::string> fields;
+        for (std::string f; iss >> f;) fields.push_back(f);
+        if (fields.size() < 2) continue;
+
+        try {
+            pairs.emplace_back(static_cast<VertexID>(std::stoul(fields[fields.size() - 2])),
+                               static_cast<VertexID>(std::stoul(fields[fields.size() - 1])));
+        } catch (...) {
+            continue; // header or malformed line
+        }
+    }
+
+    // with 'comprimido' only the compressed layout is built (no cache or shared memory)
+    if (compressed) {
+        GrafoComprimido comprimido;
+        comprimido.loadGraph(gr_path, co_path);
+        return answerLote(comprimido, pairs, out_path);
+    }
+
+    Grafo grafo;
+    loadGrafo(grafo, gr_path, co_path);
+    return answerLote(grafo, pairs, out_path);
+}
+
+// --wastar / --ara: bounded-suboptimal and anytime searches
+static int runSubOptimo(int argc, char* argv[]) {
+    const bool anytime = (std::string(argv[1]) == "--ara");
+    const int first = anytime ? 4 : 3; // index of START
+
+    if (argc != first + 5) {
+        usage();
+        return 1;
+    }
+
+    double epsilon = 1.0;
+    double deadline = 0.0;
+    VertexID start{};
+    VertexID goal{};
+    try {
+        epsilon = std::stod(argv[2]);
+        if (anytime) deadline = std::stod(argv[3]);
+        start = static_cast<VertexID>(std::stoul(argv[first]));
+        goal  = static_cast<VertexID>(std::stoul(argv[first + 1]));
+    } catch (...) {
+        std::cerr << "Error: EPS/PLAZO deben ser numeros y START/GOAL enteros.\n";
+        return 2;
+    }
+    // !(x >= 1) also rejects NaN, which would reach the integer casts of the heuristic
+    if (!std::isfinite(epsilon) || !(epsilon >= 1.0)) {
+        std::cerr << "Error: EPS debe ser un numero finito >= 1.\n";
+        return 2;
+    }
+    if (anytime && !(deadline >= 0.0)) {
+        std::cerr << "Error: PLAZO_SEG debe ser un numero >= 0.\n";
+        return 2;
+    }
+
+    const std::string gr_path  = argv[first + 2];
+    const std::string co_path  = argv[first + 3];
+    const std::string out_path = argv[first + 4];
+
+    Grafo grafo;
+    loadGrafo(grafo, gr_path, co_path);
+
+    SolucionARA ara;
+    if (anytime) {
+        AraStar busqueda;
+        ara = busqueda.solve(grafo, start, goal, epsilon, deadline);
+    } else {
+        Algoritmo algoritmo;
+        ara.best = algoritmo.solveWeightedAStar(grafo, start, goal, epsilon);
+    }
+    const SolucionAStar& resultado = ara.best;
+
+    std::ofstream out(out_path);
+    if (!out) {
+        std::cerr << "Error: no se puede abrir OUT_FILE: " << out_path << "\n";
+        return 3;
+    }
+    writePath(out, resultado);
+
+    std::cout << grafo.getNumVertices() << "\n"; // 1) number of vertices processed (.co)
+    std::cout << grafo.getNumEdges() << "\n"; // 2) number of arcs processed (.gr)
+    std::cout << resultado.total_cost << "\n"; // 3) cost of the (best) solution found
+    std::cout << resultado.expansion_count << "\n"; // 4) number of nodes expanded nodes
+    std::cout << std::fixed << std::setprecision(6) << resultado.elapsed << "\n"; // 5)  execution time (seconds)
+
+    if (!anytime) {
+        std::cout << std::setprecision(4) << epsilon << "\n"; // 6) guaranteed bound: cost <= bound * optimal
+        return 0;
+    }
+
+    // 6) one line per finished iteration: epsilon bound cost expansions elapsed cost/best
+    for (const auto& it : ara.iterations) {
+        std::cout << std::setprecision(4) << it.epsilon << " " << it.bound << " " << it.cost << " "
+                  << it.expansions << " " << std::setprecision(6) << it.elapsed << " "
+                  << std::setprecision(4) << it.cost_ratio << "\n";
+    }
+    std::cout << (ara.optimal ? "OPTIMO" : "PLAZO") << "\n"; // 7) proven optimal or stopped by the deadline
+
+    return 0;
+}
+
+// --reducido: single query on the chain/dead-end reduced graph
+static int runReducido(int argc, char* argv[]) {
+    if (argc != 7) {
+        usage();
+        return 1;
+    }
+
+    VertexID start{};
+    VertexID goal{};
+    try {
+        start = static_cast<VertexID>(std::stoul(argv[2]));
+        goal  = static_cast<VertexID>(std::stoul(argv[3]));
+    } catch (...) {
+        std::cerr << "Error: START y GOAL deben ser enteros.\n";
+        return 2;
+    }
+
+    const std::string out_path = argv[6];
+
+    Grafo grafo;
+    loadGrafo(grafo, argv[4], argv[5]);
+
+    GrafoReducido reducido;
+    reducido.build(grafo);
+    SolucionAStar resultado = reducido.solve(start, goal);
+
+    std::ofstream out(out_path);
+    if (!out) {
+        std::cerr << "Error: no se puede abrir OUT_FILE: " << out_path << "\n";
+        return 3;
+    }
+    writePath(out, resultado);
+
+    std::cout << grafo.getNumVertices() << "\n"; // 1) number of vertices processed (.co)
+    std::cout << grafo.getNumEdges() << "\n"; // 2) number of arcs processed (.gr)
+    std::cout << resultado.total_cost << "\n"; // 3) optimal cost
+    std::cout << resultado.expansion_count << "\n"; // 4) number of nodes expanded nodes
+    std::cout << std::fixed << std::setprecision(6) << resultado.elapsed << "\n"; // 5)  execution time (seconds)
+
+    return 0;
+}
+
+// --bidireccional: single query with the two-thread bidirectional A*
+static int runBidireccional(int argc, char* argv[]) {
+    if (argc != 7) {
+        usage();
+        return 1;
+    }
+
+    VertexID start{};
+    VertexID goal{};
+    try {
+        start = static_cast<VertexID>(std::stoul(argv[2]));
+        goal  = static_cast<VertexID>(std::stoul(argv[3]));
+    } catch (...) {
+        std::cerr << "Error: START y GOAL deben ser enteros.\n";
+        return 2;
+    }
+
+    const std::string out_path = argv[6];
+
+    Grafo grafo;
+    loadGrafo(grafo, argv[4], argv[5]);
+
+    BidireccionalParalelo bidireccional;
+    SolucionAStar resultado = bidireccional.solve(grafo, start, goal, 2);
+
+    std::ofstream out(out_path);
+    if (!out) {
+        std::cerr << "Error: no se puede abrir OUT_FILE: " << out_path << "\n";
+        return 3;
+    }
+    writePath(out, resultado);
+
+    std::cout << grafo.getNumVertices() << "\n"; // 1) number of vertices processed (.co)
+    std::cout << grafo.getNumEdges() << "\n"; // 2) number of arcs processed (.gr)
+    std::cout << resultado.total_cost << "\n"; // 3) optimal cost
+    std::cout << resultado.expansion_count << "\n"; // 4) number of nodes expanded nodes
+    std::cout << std::fixed << std::setprecision(6) << resultado.elapsed << "\n"; // 5)  execution time (seconds)
+
+    return 0;
+}
+
+// --paralelo: A* against the bidirectional search on 1 and 2 threads over random queries
+static int runParalelo(int argc, char* argv[]) {
+    if (argc != 5) {
+        usage();
+        return 1;
+    }
+
+    size_t num_queries = 0;
+    try {
+        num_queries = std::stoul(argv[4]);
+    } catch (...) {
+        std::cerr << "Error: NUM_CONSULTAS debe ser un entero.\n";
+        return 2;
+    }
+
+    Grafo grafo;
+    loadGrafo(grafo, argv[2], argv[3]);
+
+    const std::vector<std::pair<VertexID, VertexID>> queries = randomPairs(grafo, num_queries);
+
+    // totals for {astar, bidirectional 1 thread, bidirectional 2 threads}
+    Algoritmo algoritmo;
+    BidireccionalParalelo bidireccional;
+    size_t expansions[3] = {};
+    double times[3] = {};
+    bool same = true;
+    for (const auto& [s, t] : queries) {
+        SolucionAStar runs[3] = {algoritmo.solveAStar(grafo, s, t), bidireccional.solve(grafo, s, t, 1),
+                                 bidireccional.solve(grafo, s, t, 2)};
+        for (int k = 0; k < 3; ++k) {
+            Distance path_cost = 0;
+            for (Distance c : runs[k].costs) path_cost += c;
+            same = same && runs[k].total_cost == runs[0].total_cost;
+            same = same && (runs[k].path.empty() || path_cost == runs[k].total_cost);
+
+            expansions[k] += runs[k].expansion_count;
+            times[k] += runs[k].elapsed;
+        }
+    }
+
+    std::cout << grafo.getNumVertices() << "\n"; // 1) number of vertices processed (.co)
+    std::cout << grafo.getNumEdges() << "\n"; // 2) number of arcs processed (.gr)
+    std::cout << queries.size() << "\n"; // 3) queries
+    std::cout << std::max(1u, std::thread::hardware_concurrency()) << "\n"; // 4) hardware threads available
+
+    // 5-7) per search: threads, expansions, total time, speedup against A*
+    const char* names[3] = {"astar", "bidireccional", "bidireccional"};
+    const unsigned threads[3] = {1, 1, 2};
+    std::cout << std::fixed;
+    for (int k = 0; k < 3; ++k) {
+        double speedup = times[k] > 0 ? times[0] / times[k] : 0.0;
+        std::cout << names[k] << " " << threads[k] << " " << expansions[k] << " " << std::setprecision(6) << times[k]
+                  << " " << std::setprecision(2) << speedup << "\n";
+    }
+    std::cout << (same ? "OK" : "DISTINTOS") << "\n"; // 8) same optimal costs and consistent paths
+    writeMemoria(std::cout); // 9) memory placement
+
+    return same ? 0 : 4;
+}
+
+// --reducir: size of the reduced graph and query speedup against the full graph
+static int runReducir(int argc, char* argv[]) {
+    if (argc != 5) {
+        usage();
+        return 1;
+    }
+
+    size_t num_queries = 0;
+    try {
+        num_queries = std::stoul(argv[4]);
+    } catch (...) {
+        std::cerr << "Error: NUM_CONSULTAS debe ser un entero.\n";
+        return 2;
+    }
+
+    Grafo grafo;
+    loadGrafo(grafo, argv[2], argv[3]);
+
+    GrafoReducido reducido;
+    reducido.build(grafo);
+
+    const std::vector<std::pair<VertexID, VertexID>> queries = randomPairs(grafo, num_queries);
+
+    // totals for {dijkstra, astar} x {full, reduced}
+    size_t expansions[2][2] = {};
+    double times[2][2] = {};
+    bool same = true;
+    for (const auto& [s, t] : queries) {
+        for (int astar = 0; astar < 2; ++astar) {
+            SolucionAStar full = reducido.solveSinReducir(s, t, astar);
+            SolucionAStar red  = reducido.solve(s, t, astar);
+            same = same && full.total_cost == red.total_cost;
+
+            Distance path_cost = 0;
+            for (Distance c : red.costs) path_cost += c;
+            same = same && (red.path.empty() || path_cost == red.total_cost);
+
+            expansions[astar][0] += full.expansion_count;
+            expansions[astar][1] += red.expansion_count;
+            times[astar][0] += full.elapsed;
+            times[astar][1] += red.elapsed;
+        }
+    }
+
+    const double n = static_cast<double>(std::max<size_t>(1, grafo.getNumVertices()));
+    const double m = static_cast<double>(std::max<size_t>(1, grafo.getNumEdges()));
+
+    std::cout << grafo.getNumVertices() << "\n"; // 1) number of vertices processed (.co)
+    std::cout << grafo.getNumEdges() << "\n"; // 2) number of arcs processed (.gr)
+    std::cout << reducido.getNumCoreVertices() << "\n"; // 3) core vertices
+    std::cout << reducido.getNumCoreArcs() << "\n"; // 4) core arcs (shortcuts included)
+    std::cout << reducido.getNumDeadEnd() << "\n"; // 5) vertices in dead-end trees
+    std::cout << reducido.getNumChainInterior() << "\n"; // 6) vertices inside degree-2 chains
+    std::cout << std::fixed << std::setprecision(4);
+    std::cout << 1.0 - reducido.getNumCoreVertices() / n << "\n"; // 7) vertex reduction (fraction)
+    std::cout << 1.0 - reducido.getNumCoreArcs() / m << "\n"; // 8) arc reduction (fraction)
+    std::cout << std::setprecision(6) << reducido.getBuildTime() << "\n"; // 9) preprocessing time (seconds)
+
+    // 10-11) per algorithm: expansions full/reduced, time full/reduced, speedup
+    const char* names[2] = {"dijkstra", "astar"};
+    for (int a = 0; a < 2; ++a) {
+        double speedup = times[a][1] > 0 ? times[a][0] / times[a][1] : 0.0;
+        std::cout << names[a] << " " << expansions[a][0] << " " << expansions[a][1] << " "
+                  << times[a][0] << " " << times[a][1] << " " << std::setprecision(2) << speedup
+                  << std::setprecision(6) << "\n";
+    }
+    std::cout << (same ? "OK" : "DISTINTOS") << "\n"; // 12) same optimal costs on both graphs
+
+    return same ? 0 : 4;
+}
+
+// --transito: transit-node routing preprocessing and its share of table answers on random queries
+static int runTransito(int argc, char* argv[]) {
+    if (argc != 6) {
+        usage();
+        return 1;
+    }
+
+    size_t num_transit = 0;
+    size_t num_queries = 0;
+    try {
+        num_transit = std::stoul(argv[4]);
+        num_queries = std::stoul(argv[5]);
+    } catch (...) {
+        std::cerr << "Error: NUM_TRANSITO y NUM_CONSULTAS deben ser enteros.\n";
+        return 2;
+    }
+
+    Grafo grafo;
+    loadGrafo(grafo, argv[2], argv[3]);
+
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    RutasTransito transito;
+    transito.build(grafo, num_transit, threads);
+
+    const std::vector<std::pair<VertexID, VertexID>> queries = randomPairs(grafo, num_queries);
+
+    // times of {table answers, fallbacks} and of A* on the same queries
+    Algoritmo algoritmo;
+    double times[2] = {};
+    double astar_times[2] = {};
+    bool same = true;
+    for (const auto& [s, t] : queries) {
+        bool por_tabla = false;
+        SolucionAStar tnr = transito.solve(s, t, &por_tabla);
+        SolucionAStar ref = algoritmo.solveAStar(grafo, s, t);
+        same = same && tnr.total_cost == ref.total_cost;
+        times[por_tabla ? 0 : 1] += tnr.elapsed;
+        astar_times[por_tabla ? 0 : 1] += ref.elapsed;
+    }
+
+    const size_t answered = transito.getNumTableAnswers();
+    const double n = static_cast<double>(std::max<size_t>(1, transito.getNumQueries()));
+
+    std::cout << grafo.getNumVertices() << "\n"; // 1) number of vertices processed (.co)
+    std::cout << grafo.getNumEdges() << "\n"; // 2) number of arcs processed (.gr)
+    std::cout << transito.getNumTransit() << "\n"; // 3) transit nodes
+    std::cout << std::fixed << std::setprecision(6) << transito.getBuildTime() << "\n"; // 4) preprocessing time (seconds)
+    std::cout << std::setprecision(2) << transito.getTableBytes() / 1048576.0 << "\n"; // 5) distance table (MB)
+    std::cout << transito.getAccessBytes() / 1048576.0 << "\n"; // 6) access nodes and boxes (MB)
+    std::cout << std::setprecision(4) << transito.getValidFraction() << "\n"; // 7) vertices with both access sets
+    std::cout << std::setprecision(2) << transito.getMeanAccessNodes() << "\n"; // 8) forward access nodes per vertex
+    std::cout << answered << " " << std::setprecision(4) << answered / n << "\n"; // 9) table answers (count, share)
+
+    // 10-11) total time of the table answers / fallbacks, and of A* on the same queries
+    std::cout << std::setprecision(6) << "tabla " << times[0] << " " << astar_times[0] << "\n";
+    std::cout << "busqueda " << times[1] << " " << astar_times[1] << "\n";
+    std::cout << (same ? "OK" : "DISTINTOS") << "\n"; // 12) same optimal costs as A*
+
+    return same ? 0 : 4;
+}
+
+// --componentes: SCC statistics and a check of the O(1) reachability filter against full trees
+static int runComponentes(int argc, char* argv[]) {
+    if (argc != 5) {
+        usage();
+        return 1;
+    }
+
+    size_t num_sources = 0;
+    try {
+        num_sources = std::stoul(argv[4]);
+    } catch (...) {
+        std::cerr << "Error: NUM_FUENTES debe ser un entero.\n";
+        return 2;
+    }
+
+    Grafo grafo;
+    loadGrafo(grafo, argv[2], argv[3]);
+
+    // we rebuild the index to time it (it may come from the cache or shared memory)
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    const InformeComponentes informe = grafo.buildComponentes(threads);
+
+    // every pair (source, v): the filter must never reject a vertex the full tree reaches
+    std::vector<unsigned char> reached(grafo.getNumVertices());
+    size_t pairs = 0, unreachable = 0, rejected = 0;
+    bool sound = true;
+    Rango rango;
+    for (VertexID source : randomVertices(grafo, num_sources)) {
+        const size_t s = grafo.getIndice(source);
+        ResultadoRango tree = rango.solveArbol(grafo, source);
+
+        std::fill(reached.begin(), reached.end(), 0);
+        for (const auto& r : tree.settled) reached[grafo.getIndice(r.id)] = 1;
+
+        for (size_t t = 0; t < grafo.getNumVertices(); ++t) {
+            const bool reject = grafo.isUnreachablePorIndice(s, t);
+            pairs++;
+            unreachable += !reached[t];
+            rejected += reject;
+            sound = sound && !(reject && reached[t]);
+        }
+    }
+
+    const double n = static_cast<double>(std::max<size_t>(1, grafo.getNumVertices()));
+
+    std::cout << grafo.getNumVertices() << "\n"; // 1) number of vertices processed (.co)
+    std::cout << grafo.getNumEdges() << "\n"; // 2) number of arcs processed (.gr)
+    std::cout << grafo.getNumComponentes() << " " << informe.trimmed << "\n"; // 3) strongly connected components, vertices settled by trimming
+    std::cout << grafo.getLargestComponentSize() << "\n"; // 4) vertices in the largest SCC
+    std::cout << std::fixed << std::setprecision(4) << grafo.getLargestComponentSize() / n << "\n"; // 5) largest SCC fraction
+    std::cout << grafo.getNumComponentesDebiles() << "\n"; // 6) weakly connected components
+    std::cout << std::setprecision(6) << informe.elapsed << "\n"; // 7) index build time (seconds)
+    std::cout << threads << "\n"; // 8) threads used
+    std::cout << pairs << " " << unreachable << " " << rejected << "\n"; // 9) pairs checked, unreachable, rejected in O(1)
+    std::cout << (sound ? "OK" : "ERROR") << "\n"; // 10) no reachable pair was rejected
+
+    return sound ? 0 : 4;
 }
 
 int main(int argc, char* argv[]) {
+    // global options: --cache CACHE_FILE / --shm NOMBRE / --paginas MODO / --numa MODO
+    // (consumed before choosing the mode)
+    ModoPaginas paginas = ModoPaginas::Transparentes;
+    ModoNuma numa = ModoNuma::Ninguno;
+    while (argc > 2) {
+        const std::string option = argv[1];
+        if (option == "--cache") {
+            cache_path = argv[2];
+        } else if (option == "--shm") {
+            shm_name = argv[2];
+        } else if (option == "--paginas") {
+            if (!MemoriaGrande::parsePaginas(argv[2], paginas)) {
+                std::cerr << "Error: modo de paginas desconocido: " << argv[2] << "\n";
+                return 2;
+            }
+        } else if (option == "--numa") {
+            if (!MemoriaGrande::parseNuma(argv[2], numa)) {
+                std::cerr << "Error: modo NUMA desconocido: " << argv[2] << "\n";
+                return 2;
+            }
+        } else {
+            break;
+        }
+        argv[2] = argv[0];
+        argv += 2;
+        argc -= 2;
+    }
+    MemoriaGrande::configure(paginas, numa);
+
+    if (argc == 3 && std::string(argv[1]) == "--shm-borrar") {
+        if (!MemoriaCompartida::remove(argv[2])) {
+            std::cerr << "Error: no existe el segmento: " << argv[2] << "\n";
+            return 2;
+        }
+        return 0;
+    }
+
+    if (argc > 1 && (std::string(argv[1]) == "--wastar" || std::string(argv[1]) == "--ara")) {
+        return runSubOptimo(argc, argv);
+    }
+    if (argc > 1 && std::string(argv[1]) == "--reducido") {
+        return runReducido(argc, argv);
+    }
+    if (argc > 1 && std::string(argv[1]) == "--reducir") {
+        return runReducir(argc, argv);
+    }
+    if (argc > 1 && std::string(argv[1]) == "--bidireccional") {
+        return runBidireccional(argc, argv);
+    }
+    if (argc > 1 && std::string(argv[1]) == "--paralelo") {
+        return runParalelo(argc, argv);
+    }
+    if (argc > 1 && std::string(argv[1]) == "--transito") {
+        return runTransito(argc, argv);
+    }
+    if (argc > 1 && std::string(argv[1]) == "--componentes") {
+        return runComponentes(argc, argv);
+    }
+    if (argc > 1 && std::string(argv[1]) == "--paginas-comparar") {
+        return runPaginas(argc, argv);
+    }
+    if (argc > 1 && std::string(argv[1]) == "--lote") {
+        return runLote(argc, argv);
+    }
+    if (argc > 1 && std::string(argv[1]) == "--comprimido-ruta") {
+        return runComprimidoRuta(argc, argv);
+    }
+    if (argc > 1 && std::string(argv[1]) == "--comprimido") {
+        return runComprimido(argc, argv);
+    }
+    if (argc > 1 && std::string(argv[1]) == "--coords") {
+        return runCoords(argc, argv);
+    }
+    if (argc > 1 && (std::string(argv[1]) == "--rango" || std::string(argv[1]) == "--arbol")) {
+        return runRango(argc, argv);
+    }
+
     // we check the number of arguments we have received
     if (argc != 6) {
         usage();
@@ -36,7 +1123,7 @@ int main(int argc, char* argv[]) {
 
     // loading graph data
     Grafo grafo;
-    grafo.loadGraph(gr_path, co_path);
+    loadGrafo(grafo, gr_path, co_path);
 
 
     // here we chose the algorithm to run:
@@ -47,32 +1134,5 @@ int main(int argc, char* argv[]) {
 	//SolucionAStar resultado = algoritmo.solveDFS(grafo, start, goal);    // non-optimal
 
 
-    // we write thee path to OUT_FILE in required format: v - cost - v - cost - ... - v
-    std::ofstream out(out_path);
-    if (!out) {
-        std::cerr << "Error: no se puede abrir OUT_FILE: " << out_path << "\n";
-        return 3;
-    }
-
-    if (!resultado.path.empty()) {
-        for (size_t i = 0; i < resultado.path.size(); ++i) {
-            if (i) out << " - ";
-            out << resultado.path[i];
-
-            if (i + 1 < resultado.path.size()) {
-                out << " - (" << resultado.costs[i] << ")";
-            }
-        }
-        out << "\n";
-    }
-    out.close();
-
-    // we print the stats to the console
-    std::cout << grafo.getNumVertices() << "\n"; // 1) number of vertices processed (.co)
-    std::cout << grafo.getNumEdges() << "\n"; // 2) number of arcs processed (.gr)
-    std::cout << resultado.total_cost << "\n"; // 3) optimal cost
-    std::cout << resultado.expansion_count << "\n"; // 4) number of nodes expanded nodes
-	std::cout << std::fixed << std::setprecision(6) << resultado.elapsed << "\n"; // 5)  execution time (seconds)
-
-    return 0;
+    return writeRuta(grafo, resultado, out_path);
 }
@@ -0,0 +1,185 @@
+// memoria.cpp
+#include "memoria.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <new>
+#include <sstream>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace {
+constexpr size_t HUGE_PAGE = 2 * 1024 * 1024;
+
+// from <linux/mempolicy.h>
+constexpr int MPOL_INTERLEAVE_ = 3;
+constexpr int MPOL_LOCAL_ = 4;
+
+std::atomic<ModoPaginas> modo_paginas{ModoPaginas::Transparentes};
+std::atomic<ModoNuma> modo_numa{ModoNuma::Ninguno};
+
+std::atomic<size_t> mapped_blocks{0};
+std::atomic<size_t> mapped_bytes{0};
+std::atomic<size_t> explicit_bytes{0};
+
+size_t alignUp(size_t value, size_t align) {
+    return (value + align - 1) / align * align;
+}
+
+// Online nodes as a bit mask, from /sys/devices/system/node/online ("0", "0-1", "0,2-3")
+std::vector<unsigned long> onlineNodes(size_t& count) {
+    std::vector<unsigned long> mask;
+    count = 0;
+
+    std::ifstream in("/sys/devices/system/node/online");
+    std::string list;
+    if (!(in >> list)) return mask;
+
+    std::stringstream ss(list);
+    std::string range;
+    while (std::getline(ss, range, ',')) {
+        size_t dash = range.find('-');
+        unsigned long first = std::stoul(range.substr(0, dash));
+        unsigned long last = dash == std::string::npos ? first : std::stoul(range.substr(dash + 1));
+        for (unsigned long node = first; node <= last; ++node) {
+            const size_t word = node / (8 * sizeof(unsigned long));
+            if (mask.size() <= word) mask.resize(word + 1, 0);
+            mask[word] |= 1ul << (node % (8 * sizeof(unsigned long)));
+            count++;
+        }
+    }
+    return mask;
+}
+
+const std::vector<unsigned long>& nodeMask(size_t& count) {
+    static size_t node_count = 0;
+    static const std::vector<unsigned long> mask = onlineNodes(node_count);
+    count = node_count;
+    return mask;
+}
+
+// mbind before the first touch, so the policy decides where every page lands
+void bindBlock(void* addr, size_t len, UsoMemoria uso) {
+    const ModoNuma numa = modo_numa.load(std::memory_order_relaxed);
+    if (numa == ModoNuma::Ninguno) return;
+
+    size_t nodes = 0;
+    const auto& mask = nodeMask(nodes);
+    if (nodes < 2) return; // nothing to place
+
+    if (uso == UsoMemoria::Grafo && numa == ModoNuma::Intercalado) {
+        ::syscall(SYS_mbind, addr, len, MPOL_INTERLEAVE_, mask.data(), mask.size() * 8 * sizeof(unsigned long) + 1, 0);
+    } else {
+        ::syscall(SYS_mbind, addr, len, MPOL_LOCAL_, nullptr, 0, 0);
+    }
+}
+
+// Anonymous mapping aligned to 2 MB (the head and tail of a larger mapping are trimmed)
+void* mapAligned(size_t len) {
+    void* raw = ::mmap(nullptr, len + HUGE_PAGE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (raw == MAP_FAILED) return nullptr;
+
+    const auto start = reinterpret_cast<std::uintptr_t>(raw);
+    const auto aligned = alignUp(start, HUGE_PAGE);
+    if (aligned > start) ::munmap(raw, aligned - start);
+    const size_t tail = start + len + HUGE_PAGE - (aligned + len);
+    if (tail > 0) ::munmap(reinterpret_cast<void*>(aligned + len), tail);
+    return reinterpret_cast<void*>(aligned);
+}
+}
+
+void MemoriaGrande::configure(ModoPaginas paginas, ModoNuma numa) {
+    modo_paginas.store(paginas);
+    modo_numa.store(numa);
+}
+
+ModoNuma MemoriaGrande::getNuma() {
+    return modo_numa.load();
+}
+
+bool MemoriaGrande::parsePaginas(const std::string& text, ModoPaginas& paginas) {
+    if (text == "normales") paginas = ModoPaginas::Normal;
+    else if (text == "thp") paginas = ModoPaginas::Transparentes;
+    else if (text == "explicitas") paginas = ModoPaginas::Explicitas;
+    else return false;
+    return true;
+}
+
+bool MemoriaGrande::parseNuma(const std::string& text, ModoNuma& numa) {
+    if (text == "ninguno") numa = ModoNuma::Ninguno;
+    else if (text == "intercalado") numa = ModoNuma::Intercalado;
+    else if (text == "local") numa = ModoNuma::Local;
+    else return false;
+    return true;
+}
+
+std::string MemoriaGrande::describe() {
+    static const char* paginas[] = {"normales", "thp", "explicitas"};
+    static const char* numa[] = {"ninguno", "intercalado", "local"};
+    return std::string(paginas[static_cast<int>(modo_paginas.load())]) + "/" +
+           numa[static_cast<int>(modo_numa.load())];
+}
+
+void* MemoriaGrande::allocate(size_t bytes, UsoMemoria uso) {
+    if (bytes < UMBRAL) return ::operator new(bytes);
+
+    const size_t len = alignUp(bytes, HUGE_PAGE);
+    const ModoPaginas paginas = modo_paginas.load(std::memory_order_relaxed);
+    void* addr = nullptr;
+
+    if (paginas == ModoPaginas::Explicitas) {
+        // needs pages reserved in /proc/sys/vm/nr_hugepages; otherwise we fall back below
+        void* p = ::mmap(nullptr, len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (p != MAP_FAILED) {
+            addr = p;
+            explicit_bytes += len;
+        }
+    }
+    if (!addr) {
+        addr = mapAligned(len);
+        if (!addr) throw std::bad_alloc();
+#ifdef MADV_HUGEPAGE
+        if (paginas != ModoPaginas::Normal) ::madvise(addr, len, MADV_HUGEPAGE);
+#endif
+    }
+
+    bindBlock(addr, len, uso);
+    mapped_blocks++;
+    mapped_bytes += len;
+    return addr;
+}
+
+void MemoriaGrande::deallocate(void* p, size_t bytes) {
+    if (bytes < UMBRAL) {
+        ::operator delete(p);
+        return;
+    }
+
+    const size_t len = alignUp(bytes, HUGE_PAGE);
+    ::munmap(p, len);
+    mapped_blocks--;
+    mapped_bytes -= len;
+}
+
+InformeMemoria MemoriaGrande::report() {
+    InformeMemoria info;
+    info.bloques = mapped_blocks.load();
+    info.bytes = mapped_bytes.load();
+    info.bytes_explicitas = explicit_bytes.load();
+    nodeMask(info.nodos_numa);
+    info.nodos_numa = std::max<size_t>(1, info.nodos_numa);
+
+    std::ifstream in("/proc/self/smaps_rollup");
+    std::string key;
+    size_t value = 0;
+    while (in >> key) {
+        if (key == "AnonHugePages:" && in >> value) {
+            info.anon_huge_kb = value;
+            break;
+        }
+        in.ignore(256, '\n');
+    }
+    return info;
+}
@@ -0,0 +1,73 @@
+// memoria.hpp
+#ifndef MEMORIA_HPP
+#define MEMORIA_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Placement of the big arrays (graph and dense search state).
+// Large blocks are mapped directly with mmap, aligned to 2 MB and, depending on the
+// configuration, backed by transparent huge pages (madvise), by explicit huge pages
+// (MAP_HUGETLB, falling back to transparent huge pages) and bound with mbind:
+//  - the read-only graph is interleaved across the online NUMA nodes,
+//  - the search state of each thread is allocated on the node of the thread that touches it.
+// Only plain Linux system calls are used (no libnuma).
+enum class ModoPaginas { Normal, Transparentes, Explicitas };
+enum class ModoNuma { Ninguno, Intercalado, Local };
+enum class UsoMemoria { Grafo, Estado };
+
+struct InformeMemoria {
+    size_t bloques = 0;            // blocks currently mapped by this layer
+    size_t bytes = 0;              // bytes currently mapped by this layer
+    size_t bytes_explicitas = 0;   // bytes ever mapped on explicit huge pages
+    size_t nodos_numa = 1;         // online NUMA nodes
+    size_t anon_huge_kb = 0;       // AnonHugePages of the whole process (/proc/self/smaps_rollup)
+};
+
+class MemoriaGrande {
+public:
+    // Blocks below this size go to operator new
+    static constexpr size_t UMBRAL = 1 << 20;
+
+    static void configure(ModoPaginas paginas, ModoNuma numa);
+    static ModoNuma getNuma();
+    static bool parsePaginas(const std::string& text, ModoPaginas& paginas);
+    static bool parseNuma(const std::string& text, ModoNuma& numa);
+    static std::string describe();
+
+    static void* allocate(size_t bytes, UsoMemoria uso);
+    static void deallocate(void* p, size_t bytes);
+
+    static InformeMemoria report();
+};
+
+// std allocator over MemoriaGrande, for the vectors that hold the big arrays
+template <typename T, UsoMemoria U>
+struct AsignadorGrande {
+    using value_type = T;
+
+    template <typename O>
+    struct rebind {
+        using other = AsignadorGrande<O, U>;
+    };
+
+    AsignadorGrande() = default;
+    template <typename O>
+    AsignadorGrande(const AsignadorGrande<O, U>&) {}
+
+    T* allocate(size_t n) { return static_cast<T*>(MemoriaGrande::allocate(n * sizeof(T), U)); }
+    void deallocate(T* p, size_t n) { MemoriaGrande::deallocate(p, n * sizeof(T)); }
+
+    template <typename O>
+    bool operator==(const AsignadorGrande<O, U>&) const { return true; }
+};
+
+template <typename T>
+using VectorGrafo = std::vector<T, AsignadorGrande<T, UsoMemoria::Grafo>>;
+
+template <typename T>
+using VectorEstado = std::vector<T, AsignadorGrande<T, UsoMemoria::Estado>>;
+
+#endif // MEMORIA_HPP
@@ -0,0 +1,175 @@
+// paralelo.cpp
+#include "paralelo.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <latch>
+#include <thread>
+
+void BidireccionalParalelo::prepare(const Grafo& g) {
+    if (grafo != &g) {
+        grafo = &g;
+        for (auto& d : dir) {
+            d.dist = VectorEstado<std::atomic<Distance>>(); // reallocated by setup() on its thread
+            d.parent = VectorEstado<VertexID>();
+            d.touched.clear();
+        }
+    }
+    inversa = &g.getInversa(); // built here, before the backward thread needs it
+
+    mu = INFINITY_DIST;
+    meet = INVALID_VERTEX;
+    mu_bound.store(INFINITY_DIST);
+    stop.store(false);
+}
+
+void BidireccionalParalelo::setup(int d, size_t source, const Vertex& target) {
+    Direccion& self = dir[d];
+    const size_t n = grafo->getNumVertices();
+
+    if (self.dist.size() != n) {
+        self.dist = VectorEstado<std::atomic<Distance>>(n);
+        for (auto& x : self.dist) x.store(INFINITY_DIST, std::memory_order_relaxed);
+        self.parent.assign(n, INVALID_VERTEX);
+        self.touched.clear();
+    }
+
+    // only the labels of the previous query are cleared
+    for (VertexID v : self.touched) {
+        self.dist[v].store(INFINITY_DIST, std::memory_order_relaxed);
+        self.parent[v] = INVALID_VERTEX;
+    }
+    self.touched.clear();
+    self.heap.clear();
+    self.expansions = 0;
+
+    self.dist[source].store(0);
+    self.touched.push_back(static_cast<VertexID>(source));
+    self.heap.push_back({static_cast<VertexID>(source), Algoritmo::haversine(grafo->getVertexPorIndice(source), target), 0});
+}
+
+void BidireccionalParalelo::improve(Distance cost, size_t v) {
+    if (cost >= mu_bound.load(std::memory_order_relaxed)) return;
+
+    std::lock_guard<std::mutex> lock(meet_mutex);
+    if (cost < mu) {
+        mu = cost;
+        meet = static_cast<VertexID>(v);
+        mu_bound.store(cost);
+    }
+}
+
+bool BidireccionalParalelo::advance(int d, const Vertex& target) {
+    Direccion& self = dir[d];
+    Direccion& other = dir[1 - d];
+
+    // we drop outdated heap entries (a shorter path was found after the push)
+    while (!self.heap.empty() && self.heap.front().g != self.dist[self.heap.front().v].load(std::memory_order_relaxed)) {
+        std::pop_heap(self.heap.begin(), self.heap.end(), std::greater<QItem>());
+        self.heap.pop_back();
+    }
+
+    // stopping rule: nothing left in this queue can improve mu
+    if (self.heap.empty() || self.heap.front().key >= mu_bound.load()) {
+        stop.store(true);
+        return false;
+    }
+
+    std::pop_heap(self.heap.begin(), self.heap.end(), std::greater<QItem>());
+    const QItem cur = self.heap.back();
+    self.heap.pop_back();
+    self.expansions++;
+
+    auto relax = [&](size_t v, Distance cost) {
+        const Distance new_g = cur.g + cost;
+        if (new_g >= self.dist[v].load(std::memory_order_relaxed)) return;
+
+        if (self.dist[v].load(std::memory_order_relaxed) == INFINITY_DIST) self.touched.push_back(static_cast<VertexID>(v));
+        self.parent[v] = cur.v;
+
+        // seq_cst store/load pair: of two concurrent labels on v, at least one side sees the other
+        self.dist[v].store(new_g);
+        const Distance back = other.dist[v].load();
+        if (back != INFINITY_DIST) improve(new_g + back, v);
+
+        const Distance h = Algoritmo::haversine(grafo->getVertexPorIndice(v), target);
+        self.heap.push_back({static_cast<VertexID>(v), new_g + h, new_g});
+        std::push_heap(self.heap.begin(), self.heap.end(), std::greater<QItem>());
+    };
+
+    if (d == 0) {
+        for (const auto& e : grafo->getAdyacentesPorIndice(cur.v)) relax(e.target_index, e.cost);
+    } else {
+        for (std::uint64_t a = inversa->first_in[cur.v]; a < inversa->first_in[cur.v + 1]; ++a) {
+            relax(inversa->arcs[a].target_index, inversa->arcs[a].cost);
+        }
+    }
+    return true;
+}
+
+SolucionAStar BidireccionalParalelo::solve(const Grafo& g, VertexID start, VertexID goal, unsigned threads) {
+    auto t0 = std::chrono::high_resolution_clock::now();
+
+    SolucionAStar res;
+    res.total_cost = INFINITY_DIST;
+
+    if (!g.hasVertex(start) || !g.hasVertex(goal) || g.isUnreachable(start, goal)) {
+        auto t1 = std::chrono::high_resolution_clock::now();
+        res.elapsed = std::chrono::duration_cast<std::chrono::duration<double>>(t1 - t0).count();
+        return res;
+    }
+
+    prepare(g);
+
+    const size_t s = g.getIndice(start);
+    const size_t t = g.getIndice(goal);
+    const Vertex& start_vertex = g.getVertexPorIndice(s);
+    const Vertex& goal_vertex = g.getVertexPorIndice(t);
+
+    if (threads >= 2) {
+        // neither direction may read the other's labels before both are set up
+        std::latch ready(2);
+        std::thread backward([&]() {
+            setup(1, t, start_vertex);
+            ready.arrive_and_wait();
+            while (!stop.load(std::memory_order_relaxed) && advance(1, start_vertex)) {}
+        });
+        setup(0, s, goal_vertex);
+        if (s == t) improve(0, s);
+        ready.arrive_and_wait();
+        while (!stop.load(std::memory_order_relaxed) && advance(0, goal_vertex)) {}
+        backward.join();
+    } else {
+        setup(0, s, goal_vertex);
+        setup(1, t, start_vertex);
+        if (s == t) improve(0, s);
+        for (int d = 0; !stop.load(std::memory_order_relaxed); d ^= 1) {
+            if (!advance(d, d == 0 ? goal_vertex : start_vertex)) break;
+        }
+    }
+
+    res.expansion_count = dir[0].expansions + dir[1].expansions;
+
+    if (meet != INVALID_VERTEX) {
+        // start .. meet through the forward parents, then meet .. goal through the backward ones
+        std::vector<size_t> chain;
+        for (size_t v = meet; v != INVALID_VERTEX; v = dir[0].parent[v]) chain.push_back(v);
+        std::reverse(chain.begin(), chain.end());
+        for (size_t v = dir[1].parent[meet]; v != INVALID_VERTEX; v = dir[1].parent[v]) chain.push_back(v);
+
+        res.total_cost = 0;
+        for (size_t i = 0; i < chain.size(); ++i) {
+            res.path.push_back(g.getVertexPorIndice(chain[i]).id);
+            if (i == 0) continue;
+
+            const Distance arc = g.getArcCost(chain[i - 1], chain[i]);
+            res.costs.push_back(arc);
+            res.total_cost += arc;
+        }
+    }
+
+    auto t1 = std::chrono::high_resolution_clock::now();
+    res.elapsed = std::chrono::duration_cast<std::chrono::duration<double>>(t1 - t0).count();
+    return res;
+}
@@ -0,0 +1,74 @@
+// paralelo.hpp
+#ifndef PARALELO_HPP
+#define PARALELO_HPP
+
+#include "tipos.hpp"
+#include "grafo.hpp"
+#include "algoritmo.hpp"
+#include "memoria.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+// Bidirectional A* for a single query, one thread per direction.
+// The forward search runs on the graph towards the goal (h = haversine to the goal),
+// the backward one on the reverse arcs towards the start (h = haversine to the start).
+// Each relaxation looks up the other direction's label, and the best meeting cost mu
+// found so far is shared by both. A direction stops the query as soon as its smallest
+// key reaches mu: with a consistent heuristic each direction on its own is a complete
+// A*, so nothing left in its queue can beat mu.
+// Each direction's labels are allocated (and first touched) by the thread that searches
+// that direction, which keeps them on its NUMA node.
+class BidireccionalParalelo {
+private:
+    struct QItem {
+        VertexID v; // internal index
+        Distance key;
+        Distance g;
+        bool operator>(const QItem& o) const {
+            if (key != o.key) return key > o.key;
+            return g > o.g;
+        }
+    };
+
+    struct Direccion {
+        VectorEstado<std::atomic<Distance>> dist; // read by the other direction
+        VectorEstado<VertexID> parent;            // written and read only by its own thread
+        std::vector<VertexID> touched;
+        std::vector<QItem> heap;
+        size_t expansions = 0;
+    };
+
+    const Grafo* grafo = nullptr;
+
+    const AdyacenciaInversa* inversa = nullptr; // the graph's reverse arcs, for the backward direction
+
+    Direccion dir[2]; // 0 = forward, 1 = backward
+
+    // best meeting found so far; mu_bound is its lock-free copy for the stopping test
+    std::mutex meet_mutex;
+    Distance mu = INFINITY_DIST;
+    VertexID meet = INVALID_VERTEX;
+    std::atomic<Distance> mu_bound{INFINITY_DIST};
+    std::atomic<bool> stop{false};
+
+    void prepare(const Grafo& g);
+
+    // Clears (or allocates) the labels of direction d and seeds it with 'source';
+    // called on the thread that will run that direction
+    void setup(int d, size_t source, const Vertex& target);
+    void improve(Distance cost, size_t v);
+
+    // One expansion of direction d; false once that direction is done
+    bool advance(int d, const Vertex& target);
+
+public:
+    BidireccionalParalelo() = default;
+
+    // threads == 1 alternates both directions on the calling thread (same search, no parallelism)
+    SolucionAStar solve(const Grafo& g, VertexID start, VertexID goal, unsigned threads = 2);
+};
+
+#endif // PARALELO_HPP
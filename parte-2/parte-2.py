@@ -6,6 +6,7 @@
 #
 # MAP_BASE_PATH identifica MAP_BASE_PATH.gr y MAP_BASE_PATH.co. [file:1]
 
+import os
 import subprocess
 import sys
 from pathlib import Path
@@ -43,6 +44,11 @@ def main() -> int:
         return 3
 
     cmd = [str(cpp_bin), str(start), str(goal), str(gr_path), str(co_path), str(out_file)]
+
+    # Optional: share one in-memory copy of the map between runs (see --shm in README)
+    shm_name = os.environ.get("PARTE2_SHM")
+    if shm_name:
+        cmd[1:1] = ["--shm", shm_name]
     p = subprocess.run(cmd, capture_output=True, text=True)
 
     if p.returncode != 0:
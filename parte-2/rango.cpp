@@ -0,0 +1,56 @@
+// rango.cpp
+#include "rango.hpp"
+
+#include <cstdint>
+#include <fstream>
+
+// ------------------------------------------------------------
+// Output
+// ------------------------------------------------------------
+bool Rango::writeCSV(const std::string& path, const std::vector<ResultadoRango>& results) {
+    std::ofstream out(path);
+    if (!out) return false;
+
+    // S rows: settled vertex (vertex, parent, distance)
+    // F rows: frontier arc   (vertex, target, distance at vertex, meters left on the arc)
+    out << "source,kind,vertex,other,distance,remaining\n";
+    for (const auto& r : results) {
+        for (const auto& s : r.settled) {
+            out << r.source << ",S," << s.id << ",";
+            if (s.parent != INVALID_VERTEX) out << s.parent;
+            out << "," << s.dist << ",\n";
+        }
+        for (const auto& f : r.frontier) {
+            out << r.source << ",F," << f.from << "," << f.to << "," << f.dist_from << "," << f.remaining << "\n";
+        }
+    }
+
+    return static_cast<bool>(out);
+}
+
+// Layout (native byte order):
+//   "RNG1" | u32 num_results
+//   per result: u32 source | u64 limit | u64 num_settled | u64 num_frontier
+//               | VerticeAlcanzado[num_settled] | ArcoFrontera[num_frontier]
+bool Rango::writeBinary(const std::string& path, const std::vector<ResultadoRango>& results) {
+    std::ofstream out(path, std::ios::binary);
+    if (!out) return false;
+
+    auto put = [&](const auto& value) { out.write(reinterpret_cast<const char*>(&value), sizeof(value)); };
+
+    out.write("RNG1", 4);
+    put(static_cast<std::uint32_t>(results.size()));
+
+    for (const auto& r : results) {
+        put(static_cast<std::uint32_t>(r.source));
+        put(static_cast<std::uint64_t>(r.limit));
+        put(static_cast<std::uint64_t>(r.settled.size()));
+        put(static_cast<std::uint64_t>(r.frontier.size()));
+        out.write(reinterpret_cast<const char*>(r.settled.data()),
+                  static_cast<std::streamsize>(r.settled.size() * sizeof(VerticeAlcanzado)));
+        out.write(reinterpret_cast<const char*>(r.frontier.data()),
+                  static_cast<std::streamsize>(r.frontier.size() * sizeof(ArcoFrontera)));
+    }
+
+    return static_cast<bool>(out);
+}
@@ -0,0 +1,184 @@
+// rango.hpp
+#ifndef RANGO_HPP
+#define RANGO_HPP
+
+#include "tipos.hpp"
+#include "grafo.hpp"
+#include "busqueda.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct VerticeAlcanzado {
+    VertexID id{};
+    VertexID parent{}; // DIMACS id of the parent in the tree (INVALID_VERTEX for the source)
+    Distance dist{};
+};
+
+// Arc leaving the settled region: 'from' is inside the bound but from + cost is not
+struct ArcoFrontera {
+    VertexID from{};
+    VertexID to{};
+    Distance dist_from{};
+    Distance remaining{}; // meters of the arc that are still within the bound
+};
+
+struct ResultadoRango {
+    VertexID source = INVALID_VERTEX;
+    Distance limit = INFINITY_DIST;
+    std::vector<VerticeAlcanzado> settled;
+    std::vector<ArcoFrontera> frontier;
+    size_t expansion_count = 0;
+    double elapsed = 0.0;
+};
+
+// The searches are templates over the graph layout: any type with getNumVertices(),
+// hasVertex(), getIndice(), getVertexPorIndice() and forEachAdyacente() works
+// (Grafo and GrafoComprimido).
+class Rango {
+private:
+    BusquedaDensa busqueda;
+
+    template <typename G>
+    size_t runDijkstra(const G& g, size_t source, Distance limit, ResultadoRango* res);
+
+public:
+    Rango() = default;
+
+    // Everything within 'limit' meters of 'source' plus the arcs crossing the bound
+    template <typename G>
+    ResultadoRango solveRango(const G& g, VertexID source, Distance limit);
+
+    // Full one-to-all shortest path tree, emitted by a linear sweep over the dense labels
+    template <typename G>
+    ResultadoRango solveArbol(const G& g, VertexID source);
+
+    // One search per source spread across 'threads' workers (limit == INFINITY_DIST => full trees)
+    template <typename G>
+    static std::vector<ResultadoRango> solveLote(const G& g, const std::vector<VertexID>& sources,
+                                                 Distance limit, unsigned threads);
+
+    // Output: CSV (one row per settled vertex / frontier arc) or compact binary (native byte order)
+    static bool writeCSV(const std::string& path, const std::vector<ResultadoRango>& results);
+    static bool writeBinary(const std::string& path, const std::vector<ResultadoRango>& results);
+};
+
+// ------------------------------------------------------------
+// Distance-bounded Dijkstra over the dense state
+// ------------------------------------------------------------
+// Settles every vertex with dist <= limit. When 'res' is given, settled vertices
+// and frontier arcs are recorded in settle order. Returns the number of expansions.
+template <typename G>
+size_t Rango::runDijkstra(const G& g, size_t source, Distance limit, ResultadoRango* res) {
+    busqueda.start(g.getNumVertices(), source);
+    const EstadoBusqueda& estado = busqueda.getEstado();
+
+    size_t expansions = 0;
+
+    for (size_t u; (u = busqueda.settleNext()) != INVALID_VERTEX;) {
+        expansions++;
+
+        const Distance g_u = estado.getDist(u);
+        VertexID u_id = g.getVertexPorIndice(u).id;
+        if (res) {
+            VertexID p = estado.getParent(u);
+            res->settled.push_back({u_id, p == INVALID_VERTEX ? INVALID_VERTEX : g.getVertexPorIndice(p).id, g_u});
+        }
+
+        g.forEachAdyacente(u, [&](VertexID target_index, Distance cost) {
+            // the arc leaves the bounded region
+            if (g_u + cost > limit) {
+                if (res) res->frontier.push_back({u_id, g.getVertexPorIndice(target_index).id, g_u, limit - g_u});
+                return;
+            }
+            busqueda.relax(u, target_index, cost);
+        });
+    }
+
+    return expansions;
+}
+
+template <typename G>
+ResultadoRango Rango::solveRango(const G& g, VertexID source, Distance limit) {
+    auto t0 = std::chrono::high_resolution_clock::now();
+
+    ResultadoRango res;
+    res.source = source;
+    res.limit = limit;
+
+    if (g.hasVertex(source)) {
+        res.expansion_count = runDijkstra(g, g.getIndice(source), limit, &res);
+    }
+
+    auto t1 = std::chrono::high_resolution_clock::now();
+    res.elapsed = std::chrono::duration_cast<std::chrono::duration<double>>(t1 - t0).count();
+    return res;
+}
+
+// ------------------------------------------------------------
+// Full one-to-all tree
+// ------------------------------------------------------------
+// PHAST-style output: the search itself only writes labels, the tree is then
+// collected with one sequential pass over the dense arrays instead of being
+// appended in (random) settle order.
+template <typename G>
+ResultadoRango Rango::solveArbol(const G& g, VertexID source) {
+    auto t0 = std::chrono::high_resolution_clock::now();
+
+    ResultadoRango res;
+    res.source = source;
+    res.limit = INFINITY_DIST;
+
+    if (g.hasVertex(source)) {
+        res.expansion_count = runDijkstra(g, g.getIndice(source), INFINITY_DIST, nullptr);
+
+        const EstadoBusqueda& estado = busqueda.getEstado();
+        res.settled.reserve(estado.getTouched().size());
+        for (size_t i = 0; i < estado.size(); ++i) {
+            Distance d = estado.getDist(i);
+            if (d == INFINITY_DIST) continue;
+
+            VertexID p = estado.getParent(i);
+            res.settled.push_back({g.getVertexPorIndice(i).id,
+                                   p == INVALID_VERTEX ? INVALID_VERTEX : g.getVertexPorIndice(p).id, d});
+        }
+    }
+
+    auto t1 = std::chrono::high_resolution_clock::now();
+    res.elapsed = std::chrono::duration_cast<std::chrono::duration<double>>(t1 - t0).count();
+    return res;
+}
+
+// ------------------------------------------------------------
+// Batch of sources across threads
+// ------------------------------------------------------------
+template <typename G>
+std::vector<ResultadoRango> Rango::solveLote(const G& g, const std::vector<VertexID>& sources,
+                                             Distance limit, unsigned threads) {
+    std::vector<ResultadoRango> results(sources.size());
+    std::atomic<size_t> next{0};
+
+    // each worker owns its dense state and grabs the next pending source
+    auto worker = [&]() {
+        Rango rango;
+        for (size_t i = next++; i < sources.size(); i = next++) {
+            results[i] = (limit == INFINITY_DIST) ? rango.solveArbol(g, sources[i])
+                                                  : rango.solveRango(g, sources[i], limit);
+        }
+    };
+
+    threads = std::max(1u, std::min<unsigned>(threads, static_cast<unsigned>(sources.size())));
+
+    std::vector<std::thread> pool;
+    for (unsigned t = 1; t < threads; ++t) pool.emplace_back(worker);
+    worker();
+    for (auto& th : pool) th.join();
+
+    return results;
+}
+
+#endif // RANGO_HPP
@@ -0,0 +1,320 @@
+// reducido.cpp
+#include "reducido.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+
+// ------------------------------------------------------------
+// Preprocessing
+// ------------------------------------------------------------
+void GrafoReducido::build(const Grafo& g) {
+    auto t0 = std::chrono::high_resolution_clock::now();
+
+    grafo = &g;
+    const size_t n = g.getNumVertices();
+
+    // 1) undirected, de-duplicated neighbor lists (CSR)
+    std::vector<std::uint64_t> first_nb(n + 1, 0);
+    for (size_t u = 0; u < n; ++u) {
+        for (const auto& e : g.getAdyacentesPorIndice(u)) {
+            if (e.target_index == u) continue;
+            first_nb[u + 1]++;
+            first_nb[e.target_index + 1]++;
+        }
+    }
+    for (size_t i = 1; i <= n; ++i) first_nb[i] += first_nb[i - 1];
+
+    std::vector<VertexID> nb(first_nb[n]);
+    {
+        std::vector<std::uint64_t> pos(first_nb.begin(), first_nb.end() - 1);
+        for (size_t u = 0; u < n; ++u) {
+            for (const auto& e : g.getAdyacentesPorIndice(u)) {
+                if (e.target_index == u) continue;
+                nb[pos[u]++] = e.target_index;
+                nb[pos[e.target_index]++] = static_cast<VertexID>(u);
+            }
+        }
+    }
+
+    std::vector<std::uint32_t> degree(n);
+    for (size_t u = 0; u < n; ++u) {
+        auto first = nb.begin() + static_cast<std::ptrdiff_t>(first_nb[u]);
+        auto last = nb.begin() + static_cast<std::ptrdiff_t>(first_nb[u + 1]);
+        std::sort(first, last);
+        degree[u] = static_cast<std::uint32_t>(std::unique(first, last) - first);
+    }
+    auto neighbors = [&](size_t u) {
+        return std::span<const VertexID>(nb.data() + first_nb[u], degree[u]);
+    };
+
+    // 2) 1-shell: we peel vertices of degree <= 1 until none is left
+    std::vector<unsigned char> removed(n, 0);
+    std::vector<std::uint32_t> core_degree(degree);
+    std::vector<VertexID> queue;
+    for (size_t u = 0; u < n; ++u) {
+        if (core_degree[u] <= 1) queue.push_back(static_cast<VertexID>(u));
+    }
+    dead_end_count = 0;
+    while (!queue.empty()) {
+        VertexID u = queue.back();
+        queue.pop_back();
+        if (removed[u]) continue;
+
+        removed[u] = 1;
+        dead_end_count++;
+        for (VertexID w : neighbors(u)) {
+            if (!removed[w] && --core_degree[w] == 1) queue.push_back(w);
+        }
+    }
+
+    // 3) chains of core vertices with exactly two core neighbors
+    chain_vertices.clear();
+    chain_interior_count = 0;
+
+    auto is_chain = [&](size_t u) { return !removed[u] && core_degree[u] == 2; };
+    auto other_core = [&](size_t u, size_t prev) -> size_t {
+        for (VertexID w : neighbors(u)) {
+            if (!removed[w] && w != prev) return w;
+        }
+        return prev;
+    };
+
+    // shortcuts collected as (source, arc); the chain order is stored in chain_vertices
+    std::vector<std::pair<VertexID, ArcoNucleo>> shortcuts;
+
+    // adds a->b if every arc along a, interior..., b exists
+    auto add_shortcut = [&](size_t a, const std::vector<VertexID>& interior, size_t b) {
+        Distance total = 0;
+        size_t prev = a;
+        for (size_t i = 0; i <= interior.size(); ++i) {
+            size_t next = (i < interior.size()) ? interior[i] : b;
+            Distance c = grafo->getArcCost(prev, next);
+            if (c == INFINITY_DIST) return;
+            total += c;
+            prev = next;
+        }
+
+        ArcoNucleo arc;
+        arc.target_index = static_cast<VertexID>(b);
+        arc.chain_length = static_cast<std::uint32_t>(interior.size());
+        arc.chain_begin = chain_vertices.size();
+        arc.cost = total;
+        chain_vertices.insert(chain_vertices.end(), interior.begin(), interior.end());
+        shortcuts.emplace_back(static_cast<VertexID>(a), arc);
+    };
+
+    std::vector<unsigned char> in_chain(n, 0);
+    std::vector<VertexID> left, right, interior;
+    for (size_t v = 0; v < n; ++v) {
+        if (!is_chain(v) || in_chain[v]) continue;
+
+        // we walk both ways from v until a vertex that is not a chain vertex
+        auto [n1, n2] = [&]() {
+            size_t a = other_core(v, INVALID_VERTEX);
+            return std::pair<size_t, size_t>{a, other_core(v, a)};
+        }();
+
+        in_chain[v] = 1;
+        bool cycle = false;
+
+        auto walk = [&](size_t first, std::vector<VertexID>& seq) -> size_t {
+            seq.clear();
+            size_t prev = v, cur = first;
+            while (is_chain(cur) && !in_chain[cur]) {
+                in_chain[cur] = 1;
+                seq.push_back(static_cast<VertexID>(cur));
+                size_t next = other_core(cur, prev);
+                prev = cur;
+                cur = next;
+            }
+            if (cur == v || (is_chain(cur) && in_chain[cur])) cycle = true;
+            return cur;
+        };
+
+        size_t a = walk(n1, left);
+        size_t b = cycle ? v : walk(n2, right);
+
+        if (cycle) {
+            // an isolated ring of degree-2 vertices: v stays in the core as its only endpoint
+            in_chain[v] = 0;
+            for (VertexID u : left) removed[u] = 1;
+            chain_interior_count += left.size();
+            continue;
+        }
+
+        // interior in order a -> b
+        interior.assign(left.rbegin(), left.rend());
+        interior.push_back(static_cast<VertexID>(v));
+        interior.insert(interior.end(), right.begin(), right.end());
+
+        for (VertexID u : interior) removed[u] = 1;
+        chain_interior_count += interior.size();
+
+        if (a == b) continue; // a loop back to the same vertex never shortens anything
+
+        add_shortcut(a, interior, b);
+        std::reverse(interior.begin(), interior.end());
+        add_shortcut(b, interior, a);
+    }
+
+    // 4) parts: connected components of removed vertices
+    part.assign(n, INVALID_VERTEX);
+    VertexID parts = 0;
+    for (size_t v = 0; v < n; ++v) {
+        if (!removed[v] || part[v] != INVALID_VERTEX) continue;
+
+        queue.assign(1, static_cast<VertexID>(v));
+        part[v] = parts;
+        while (!queue.empty()) {
+            VertexID u = queue.back();
+            queue.pop_back();
+            for (VertexID w : neighbors(u)) {
+                if (removed[w] && part[w] == INVALID_VERTEX) {
+                    part[w] = parts;
+                    queue.push_back(w);
+                }
+            }
+        }
+        parts++;
+    }
+
+    // 5) core adjacency: original core -> core arcs plus shortcuts
+    core_vertex_count = 0;
+    first_core_out.assign(n + 1, 0);
+    for (size_t u = 0; u < n; ++u) {
+        if (removed[u]) continue;
+        core_vertex_count++;
+        for (const auto& e : g.getAdyacentesPorIndice(u)) {
+            if (!removed[e.target_index]) first_core_out[u + 1]++;
+        }
+    }
+    for (const auto& [u, arc] : shortcuts) first_core_out[u + 1]++;
+    for (size_t i = 1; i <= n; ++i) first_core_out[i] += first_core_out[i - 1];
+
+    core_arcs.assign(first_core_out[n], ArcoNucleo{});
+    std::vector<std::uint64_t> pos(first_core_out.begin(), first_core_out.end() - 1);
+    for (size_t u = 0; u < n; ++u) {
+        if (removed[u]) continue;
+        for (const auto& e : g.getAdyacentesPorIndice(u)) {
+            if (!removed[e.target_index]) core_arcs[pos[u]++] = ArcoNucleo{e.target_index, 0, 0, e.cost};
+        }
+    }
+    for (const auto& [u, arc] : shortcuts) core_arcs[pos[u]++] = arc;
+
+    auto t1 = std::chrono::high_resolution_clock::now();
+    build_time = std::chrono::duration_cast<std::chrono::duration<double>>(t1 - t0).count();
+}
+
+// ------------------------------------------------------------
+// Queries
+// ------------------------------------------------------------
+SolucionAStar GrafoReducido::search(VertexID start, VertexID goal, bool astar, bool reduced) {
+    auto t0 = std::chrono::high_resolution_clock::now();
+
+    SolucionAStar res;
+    res.total_cost = INFINITY_DIST;
+
+    if (!grafo || !grafo->hasVertex(start) || !grafo->hasVertex(goal) || grafo->isUnreachable(start, goal)) {
+        auto t1 = std::chrono::high_resolution_clock::now();
+        res.elapsed = std::chrono::duration_cast<std::chrono::duration<double>>(t1 - t0).count();
+        return res;
+    }
+
+    const Grafo& g = *grafo;
+    const size_t s = g.getIndice(start);
+    const size_t t = g.getIndice(goal);
+    const Vertex& goal_vertex = g.getVertexPorIndice(t);
+
+    if (estado.size() != g.getNumVertices()) {
+        estado.init(g.getNumVertices());
+        via_shortcut.assign(g.getNumVertices(), NO_SHORTCUT);
+    } else {
+        estado.reset();
+    }
+    heap.clear();
+
+    // parts whose original arcs are searched (the ones holding start and goal)
+    const VertexID part_s = part[s];
+    const VertexID part_t = part[t];
+    auto active = [&](size_t v) {
+        return part[v] != INVALID_VERTEX && (part[v] == part_s || part[v] == part_t);
+    };
+
+    auto heuristic = [&](size_t v) -> Distance {
+        return astar ? Algoritmo::haversine(g.getVertexPorIndice(v), goal_vertex) : 0;
+    };
+
+    auto relax = [&](size_t u, Distance gu, size_t v, Distance cost, std::uint64_t arc) {
+        Distance new_g = gu + cost;
+        if (new_g >= estado.getDist(v)) return;
+        estado.update(v, static_cast<VertexID>(u), new_g);
+        via_shortcut[v] = arc;
+        heap.push_back({static_cast<VertexID>(v), new_g + heuristic(v), new_g});
+        std::push_heap(heap.begin(), heap.end(), std::greater<QItem>());
+    };
+
+    estado.update(s, INVALID_VERTEX, 0);
+    via_shortcut[s] = NO_SHORTCUT;
+    heap.push_back({static_cast<VertexID>(s), heuristic(s), 0});
+
+    size_t expansions = 0;
+    while (!heap.empty()) {
+        std::pop_heap(heap.begin(), heap.end(), std::greater<QItem>());
+        QItem cur = heap.back();
+        heap.pop_back();
+
+        if (cur.g != estado.getDist(cur.v)) continue;
+        expansions++;
+
+        if (cur.v == t) {
+            res.total_cost = cur.g;
+            break;
+        }
+
+        if (!reduced || part[cur.v] != INVALID_VERTEX) {
+            // full graph, or a vertex inside an active part: original arcs
+            for (const auto& e : g.getAdyacentesPorIndice(cur.v)) {
+                relax(cur.v, cur.g, e.target_index, e.cost, NO_SHORTCUT);
+            }
+            continue;
+        }
+
+        // core vertex: core arcs and shortcuts, plus the way into the active parts
+        for (std::uint64_t a = first_core_out[cur.v]; a < first_core_out[cur.v + 1]; ++a) {
+            const ArcoNucleo& arc = core_arcs[a];
+            relax(cur.v, cur.g, arc.target_index, arc.cost, arc.chain_length ? a : NO_SHORTCUT);
+        }
+        if (part_s != INVALID_VERTEX || part_t != INVALID_VERTEX) {
+            for (const auto& e : g.getAdyacentesPorIndice(cur.v)) {
+                if (active(e.target_index)) relax(cur.v, cur.g, e.target_index, e.cost, NO_SHORTCUT);
+            }
+        }
+    }
+
+    if (res.total_cost != INFINITY_DIST) {
+        // parent chain with the shortcuts expanded into their interior vertices
+        std::vector<size_t> rev;
+        for (size_t v = t; v != INVALID_VERTEX; v = estado.getParent(v)) {
+            rev.push_back(v);
+            std::uint64_t a = via_shortcut[v];
+            if (a == NO_SHORTCUT || estado.getParent(v) == INVALID_VERTEX) continue;
+
+            const ArcoNucleo& arc = core_arcs[a];
+            for (std::uint32_t k = arc.chain_length; k-- > 0;) {
+                rev.push_back(chain_vertices[arc.chain_begin + k]);
+            }
+        }
+        std::reverse(rev.begin(), rev.end());
+
+        for (size_t i = 0; i < rev.size(); ++i) {
+            res.path.push_back(g.getVertexPorIndice(rev[i]).id);
+            if (i) res.costs.push_back(grafo->getArcCost(rev[i - 1], rev[i]));
+        }
+    }
+
+    auto t1 = std::chrono::high_resolution_clock::now();
+    res.elapsed = std::chrono::duration_cast<std::chrono::duration<double>>(t1 - t0).count();
+    res.expansion_count = expansions;
+    return res;
+}
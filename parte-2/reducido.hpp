@@ -0,0 +1,83 @@
+// reducido.hpp
+#ifndef REDUCIDO_HPP
+#define REDUCIDO_HPP
+
+#include "tipos.hpp"
+#include "grafo.hpp"
+#include "estado.hpp"
+#include "algoritmo.hpp"
+
+#include <cstdint>
+#include <vector>
+
+// Road-graph reduction (undirected degrees, arc directions are kept):
+//  - dead-end trees (the 1-shell) are peeled off the core;
+//  - maximal chains of degree-2 core vertices are replaced by one shortcut arc
+//    per direction in which the whole chain is traversable.
+// Each removed vertex belongs to a "part" (connected removed vertices) that
+// touches at most two core vertices, so a shortest path between vertices outside
+// a part never needs to go through it except along the shortcut.
+//
+// Queries run on a hybrid graph: core arcs and shortcuts everywhere, plus the
+// original arcs of the parts that contain the start or the goal. Shortcuts on
+// the result are expanded back into the original vertices.
+class GrafoReducido {
+private:
+    struct ArcoNucleo {
+        VertexID target_index{};
+        std::uint32_t chain_length{}; // 0 => original arc
+        std::uint64_t chain_begin{};  // first interior vertex in chain_vertices
+        Distance cost{};
+    };
+
+    struct QItem {
+        VertexID v; // internal index
+        Distance f;
+        Distance g;
+        bool operator>(const QItem& o) const {
+            if (f != o.f) return f > o.f;
+            return g > o.g;
+        }
+    };
+
+    static constexpr std::uint64_t NO_SHORTCUT = ~std::uint64_t{0};
+
+    const Grafo* grafo = nullptr;
+
+    std::vector<VertexID> part; // INVALID_VERTEX => core vertex
+    std::vector<std::uint64_t> first_core_out;
+    std::vector<ArcoNucleo> core_arcs;
+    std::vector<VertexID> chain_vertices;
+
+    size_t core_vertex_count = 0;
+    size_t dead_end_count = 0;
+    size_t chain_interior_count = 0;
+    double build_time = 0.0;
+
+    // query state
+    EstadoBusqueda estado;
+    std::vector<std::uint64_t> via_shortcut; // core arc used to reach each vertex (NO_SHORTCUT if original)
+    std::vector<QItem> heap;
+
+    SolucionAStar search(VertexID start, VertexID goal, bool astar, bool reduced);
+
+public:
+    GrafoReducido() = default;
+
+    // 'g' must outlive this object
+    void build(const Grafo& g);
+
+    // Exact shortest path on the reduced graph (A* with haversine, or Dijkstra)
+    SolucionAStar solve(VertexID start, VertexID goal, bool astar = true) { return search(start, goal, astar, true); }
+
+    // Same search code on the full graph, as the baseline for the speedup
+    SolucionAStar solveSinReducir(VertexID start, VertexID goal, bool astar = true) { return search(start, goal, astar, false); }
+
+    size_t getNumCoreVertices() const { return core_vertex_count; }
+    size_t getNumCoreArcs() const { return core_arcs.size(); }
+    size_t getNumDeadEnd() const { return dead_end_count; }
+    size_t getNumChainInterior() const { return chain_interior_count; }
+    double getBuildTime() const { return build_time; }
+};
+
+#endif // REDUCIDO_HPP
@@ -0,0 +1,117 @@
+// sesion.hpp
+#ifndef SESION_HPP
+#define SESION_HPP
+
+#include "tipos.hpp"
+#include "busqueda.hpp"
+#include "algoritmo.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+struct EstadisticasSesion {
+    size_t queries = 0;
+    size_t hits = 0;    // goal already settled (or source tree already exhausted)
+    size_t resumes = 0; // same source, the search continued from the previous frontier
+    size_t fresh = 0;   // new source, search started from scratch
+    size_t rejected = 0; // unknown id or unreachable pair, answered without searching
+};
+
+// Resumable Dijkstra: the settled tree and the open frontier are kept between
+// queries, so consecutive queries with the same source only pay for the part
+// of the tree that was not explored yet. Templates over the graph layout, like
+// Algoritmo (Grafo or GrafoComprimido).
+class SesionBusqueda {
+private:
+    BusquedaDensa busqueda;
+    size_t source_index = INVALID_VERTEX;
+
+    EstadisticasSesion stats;
+
+    template <typename G>
+    SolucionAStar buildSolution(const G& g, size_t goal) const;
+
+public:
+    SesionBusqueda() = default;
+
+    template <typename G>
+    SolucionAStar query(const G& g, VertexID start, VertexID goal);
+
+    const EstadisticasSesion& getEstadisticas() const { return stats; }
+};
+
+template <typename G>
+SolucionAStar SesionBusqueda::query(const G& g, VertexID start, VertexID goal) {
+    auto t0 = std::chrono::high_resolution_clock::now();
+
+    SolucionAStar res;
+    res.total_cost = INFINITY_DIST;
+
+    stats.queries++;
+
+    if (!g.hasVertex(start) || !g.hasVertex(goal) ||
+        g.isUnreachablePorIndice(g.getIndice(start), g.getIndice(goal))) {
+        stats.rejected++;
+        auto t1 = std::chrono::high_resolution_clock::now();
+        res.elapsed = std::chrono::duration_cast<std::chrono::duration<double>>(t1 - t0).count();
+        return res;
+    }
+
+    size_t s = g.getIndice(start);
+    size_t t = g.getIndice(goal);
+
+    const EstadoBusqueda& estado = busqueda.getEstado();
+
+    if (s != source_index || estado.size() != g.getNumVertices()) {
+        busqueda.start(g.getNumVertices(), s);
+        source_index = s;
+        stats.fresh++;
+    } else if (estado.isSettled(t) || busqueda.isExhausted()) {
+        // answered by the tree we already have
+        stats.hits++;
+    } else {
+        stats.resumes++;
+    }
+
+    size_t expansions = 0;
+
+    // we continue the Dijkstra until the goal is settled
+    while (!estado.isSettled(t)) {
+        const size_t u = busqueda.settleNext();
+        if (u == INVALID_VERTEX) break;
+        expansions++;
+
+        g.forEachAdyacente(u, [&](VertexID target_index, Distance cost) { busqueda.relax(u, target_index, cost); });
+    }
+
+    if (estado.isSettled(t)) res = buildSolution(g, t);
+    res.expansion_count = expansions;
+
+    auto t1 = std::chrono::high_resolution_clock::now();
+    res.elapsed = std::chrono::duration_cast<std::chrono::duration<double>>(t1 - t0).count();
+    return res;
+}
+
+template <typename G>
+SolucionAStar SesionBusqueda::buildSolution(const G& g, size_t goal) const {
+    const EstadoBusqueda& estado = busqueda.getEstado();
+    SolucionAStar res;
+    res.total_cost = estado.getDist(goal);
+
+    // we follow the parents back to the source
+    std::vector<size_t> chain;
+    for (size_t v = goal; v != INVALID_VERTEX; v = estado.getParent(v)) {
+        chain.push_back(v);
+    }
+    std::reverse(chain.begin(), chain.end());
+
+    for (size_t i = 0; i < chain.size(); ++i) {
+        res.path.push_back(g.getVertexPorIndice(chain[i]).id);
+        if (i) res.costs.push_back(estado.getDist(chain[i]) - estado.getDist(chain[i - 1]));
+    }
+    return res;
+}
+
+#endif // SESION_HPP
@@ -19,6 +19,7 @@ struct Vertex {
 
 struct Edge {
     VertexID target{};
+    VertexID target_index{}; // internal index of 'target' (fits in the padding before cost)
     Distance cost{};
 };
 
@@ -0,0 +1,319 @@
+// transito.cpp
+#include "transito.hpp"
+#include "busqueda.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <numeric>
+#include <random>
+#include <thread>
+
+namespace {
+// What a Dijkstra does after settling a vertex
+enum class Visita { Expandir, Parar };
+
+// Dense search and settle order of one worker
+struct Trabajador {
+    BusquedaDensa busqueda;
+    std::vector<VertexID> order;
+
+    // Dijkstra from 'source' over arcs(u, relax); visit(v, dist) decides on every settled vertex.
+    // Returns false if 'limit' settled vertices were reached before the search ended.
+    template <typename Arcs, typename Visit>
+    bool run(size_t n, size_t source, size_t limit, Arcs&& arcs, Visit&& visit) {
+        busqueda.start(n, source);
+        order.clear();
+
+        for (size_t u; (u = busqueda.settleNext()) != INVALID_VERTEX;) {
+            if (order.size() == limit) return false;
+            order.push_back(static_cast<VertexID>(u));
+            if (visit(u, busqueda.getEstado().getDist(u)) == Visita::Parar) break;
+
+            arcs(u, [&](size_t v, Distance cost) { busqueda.relax(u, v, cost); });
+        }
+        return true;
+    }
+};
+
+// Runs work(state, i) for i in [0, count) on 'threads' workers, each with its own state:
+// init(state) when the worker starts, finish(state) when it runs out of items
+template <typename State, typename Init, typename Work, typename Finish>
+void parallelFor(size_t count, unsigned threads, Init&& init, Work&& work, Finish&& finish) {
+    std::atomic<size_t> next{0};
+    auto worker = [&]() {
+        State state;
+        init(state);
+        for (size_t i = next++; i < count; i = next++) work(state, i);
+        finish(state);
+    };
+
+    threads = std::max(1u, std::min<unsigned>(threads, static_cast<unsigned>(std::max<size_t>(1, count))));
+    std::vector<std::thread> pool;
+    for (unsigned t = 1; t < threads; ++t) pool.emplace_back(worker);
+    worker();
+    for (auto& th : pool) th.join();
+}
+}
+
+// ------------------------------------------------------------
+// Preprocessing
+// ------------------------------------------------------------
+void RutasTransito::build(const Grafo& g, size_t num_transit, unsigned threads) {
+    auto t0 = std::chrono::high_resolution_clock::now();
+
+    grafo = &g;
+    queries = 0;
+    table_answers = 0;
+
+    selectTransit(num_transit, threads);
+    buildAccess(threads);
+    buildTable(threads);
+
+    auto t1 = std::chrono::high_resolution_clock::now();
+    build_time = std::chrono::duration_cast<std::chrono::duration<double>>(t1 - t0).count();
+}
+
+// Importance of v: number of vertices below v in the sampled shortest-path trees.
+// Vertices on long-distance routes carry whole regions below them.
+void RutasTransito::selectTransit(size_t count, unsigned threads) {
+    const Grafo& g = *grafo;
+    const size_t n = g.getNumVertices();
+
+    std::mt19937 rng(20240607);
+    std::vector<VertexID> samples;
+    for (size_t i = 0; i < std::min(NUM_SAMPLES, n); ++i) samples.push_back(static_cast<VertexID>(rng() % n));
+
+    struct Muestreo : Trabajador {
+        std::vector<std::uint32_t> below;
+        std::vector<std::uint64_t> score;
+    };
+
+    std::vector<std::uint64_t> score(n, 0);
+    std::mutex score_mutex;
+    auto forward = [&](size_t u, auto&& relax) {
+        for (const auto& e : g.getAdyacentesPorIndice(u)) relax(e.target_index, e.cost);
+    };
+
+    parallelFor<Muestreo>(
+        samples.size(), threads,
+        [&](Muestreo& w) {
+            w.busqueda.init(n);
+            w.below.assign(n, 0);
+            w.score.assign(n, 0);
+        },
+        [&](Muestreo& w, size_t i) {
+            w.run(n, samples[i], n, forward, [](size_t, Distance) { return Visita::Expandir; });
+
+            // subtree sizes, children before parents (the root would count the whole tree)
+            for (auto it = w.order.rbegin(); it != w.order.rend(); ++it) {
+                const VertexID v = *it;
+                const VertexID p = w.busqueda.getEstado().getParent(v);
+                w.below[v] += 1;
+                if (p == INVALID_VERTEX) continue;
+                w.score[v] += w.below[v] - 1;
+                w.below[p] += w.below[v];
+            }
+            for (VertexID v : w.order) w.below[v] = 0;
+        },
+        [&](Muestreo& w) {
+            std::lock_guard<std::mutex> lock(score_mutex);
+            for (size_t v = 0; v < n; ++v) score[v] += w.score[v];
+        });
+
+    count = std::min(count, n);
+    std::vector<VertexID> by_score(n);
+    std::iota(by_score.begin(), by_score.end(), 0u);
+    std::partial_sort(by_score.begin(), by_score.begin() + static_cast<std::ptrdiff_t>(count), by_score.end(),
+                      [&](VertexID a, VertexID b) { return score[a] != score[b] ? score[a] > score[b] : a < b; });
+
+    transit.assign(by_score.begin(), by_score.begin() + static_cast<std::ptrdiff_t>(count));
+    transit_rank.assign(n, NO_TRANSIT);
+    for (size_t i = 0; i < transit.size(); ++i) transit_rank[transit[i]] = static_cast<std::uint32_t>(i);
+}
+
+// Forward and backward pruned searches from every vertex
+void RutasTransito::buildAccess(unsigned threads) {
+    const Grafo& g = *grafo;
+    const size_t n = g.getNumVertices();
+
+    for (int d = 0; d < 2; ++d) {
+        Accesos& acc = access[d];
+        acc.box.assign(n, Caja{});
+        acc.valid.assign(n, 0);
+
+        std::vector<std::vector<Acceso>> found(n);
+        auto arcs = [&](size_t u, auto&& relax) {
+            for (const auto& e : d == 0 ? g.getAdyacentesPorIndice(u) : g.getEntrantesPorIndice(u)) {
+                relax(e.target_index, e.cost);
+            }
+        };
+
+        // a label is covered when its path already went through a transit node
+        struct Cubierta : Trabajador {
+            std::vector<unsigned char> covered;
+        };
+
+        parallelFor<Cubierta>(
+            n, threads,
+            [&](Cubierta& w) {
+                w.busqueda.init(n);
+                w.covered.assign(n, 0);
+            },
+            [&](Cubierta& w, size_t v) {
+                std::vector<Acceso> nodes;
+                const Vertex& origin = g.getVertexPorIndice(v);
+                Caja box{origin.latitude, origin.latitude, origin.longitude, origin.longitude};
+
+                const EstadoBusqueda& estado = w.busqueda.getEstado();
+                w.busqueda.start(n, v);
+                w.covered[v] = 0;
+
+                size_t uncovered = 1; // uncovered labels waiting in the heap
+                size_t settled = 0;
+                bool complete = true;
+
+                // once every queued label is covered, nothing else can be an access node or in the box
+                while (uncovered > 0) {
+                    const size_t cur = w.busqueda.settleNext();
+                    if (cur == INVALID_VERTEX) break;
+
+                    if (++settled > MAX_SEARCH_SPACE) {
+                        complete = false;
+                        break;
+                    }
+
+                    const bool is_transit = transit_rank[cur] != NO_TRANSIT;
+                    if (!w.covered[cur]) {
+                        uncovered--;
+
+                        const Vertex& p = g.getVertexPorIndice(cur);
+                        box.lat_min = std::min(box.lat_min, p.latitude);
+                        box.lat_max = std::max(box.lat_max, p.latitude);
+                        box.lon_min = std::min(box.lon_min, p.longitude);
+                        box.lon_max = std::max(box.lon_max, p.longitude);
+
+                        if (is_transit) nodes.push_back({transit_rank[cur], estado.getDist(cur)});
+                    }
+
+                    const bool child_covered = w.covered[cur] || is_transit;
+                    arcs(cur, [&](size_t u, Distance cost) {
+                        const bool queued_uncovered = estado.getDist(u) != INFINITY_DIST && !w.covered[u];
+                        if (!w.busqueda.relax(cur, u, cost)) return;
+
+                        if (queued_uncovered) uncovered--;
+                        w.covered[u] = child_covered;
+                        if (!child_covered) uncovered++;
+                    });
+                }
+
+                if (complete && nodes.size() <= MAX_ACCESS) {
+                    acc.valid[v] = 1;
+                    acc.box[v] = box;
+                    found[v] = std::move(nodes);
+                }
+            },
+            [](Cubierta&) {});
+
+        acc.first.assign(n + 1, 0);
+        for (size_t v = 0; v < n; ++v) acc.first[v + 1] = acc.first[v] + found[v].size();
+        acc.nodes.clear();
+        acc.nodes.reserve(acc.first[n]);
+        for (auto& list : found) acc.nodes.insert(acc.nodes.end(), list.begin(), list.end());
+    }
+}
+
+// One Dijkstra per transit node, stopped once every transit node is settled
+void RutasTransito::buildTable(unsigned threads) {
+    const Grafo& g = *grafo;
+    const size_t n = g.getNumVertices();
+    const size_t k = transit.size();
+    table.assign(k * k, INFINITY_DIST);
+
+    auto forward = [&](size_t u, auto&& relax) {
+        for (const auto& e : g.getAdyacentesPorIndice(u)) relax(e.target_index, e.cost);
+    };
+
+    parallelFor<Trabajador>(
+        k, threads, [&](Trabajador& w) { w.busqueda.init(n); },
+        [&](Trabajador& w, size_t a) {
+            size_t pending = k;
+            Distance* row = table.data() + a * k;
+            w.run(n, transit[a], n, forward, [&](size_t u, Distance dist) {
+                if (transit_rank[u] != NO_TRANSIT) {
+                    row[transit_rank[u]] = dist;
+                    pending--;
+                }
+                return pending > 0 ? Visita::Expandir : Visita::Parar;
+            });
+        },
+        [](Trabajador&) {});
+}
+
+size_t RutasTransito::getAccessBytes() const {
+    size_t bytes = transit_rank.size() * sizeof(std::uint32_t);
+    for (const auto& acc : access) {
+        bytes += acc.first.size() * sizeof(std::uint64_t) + acc.nodes.size() * sizeof(Acceso) +
+                 acc.box.size() * sizeof(Caja) + acc.valid.size();
+    }
+    return bytes;
+}
+
+double RutasTransito::getValidFraction() const {
+    const size_t n = access[0].valid.size();
+    if (n == 0) return 0.0;
+    size_t both = 0;
+    for (size_t v = 0; v < n; ++v) both += access[0].valid[v] && access[1].valid[v];
+    return static_cast<double>(both) / static_cast<double>(n);
+}
+
+double RutasTransito::getMeanAccessNodes() const {
+    size_t valid = 0;
+    for (unsigned char f : access[0].valid) valid += f;
+    return valid ? static_cast<double>(access[0].nodes.size()) / static_cast<double>(valid) : 0.0;
+}
+
+// ------------------------------------------------------------
+// Queries
+// ------------------------------------------------------------
+SolucionAStar RutasTransito::solve(VertexID start, VertexID goal, bool* por_tabla) {
+    auto t0 = std::chrono::high_resolution_clock::now();
+    if (por_tabla) *por_tabla = false;
+    queries++;
+
+    const Grafo& g = *grafo;
+    if (!g.hasVertex(start) || !g.hasVertex(goal) || g.isUnreachable(start, goal)) {
+        return fallback.solveAStar(g, start, goal);
+    }
+
+    const size_t s = g.getIndice(start);
+    const size_t t = g.getIndice(goal);
+    const Accesos& fw = access[0];
+    const Accesos& bw = access[1];
+
+    // locality filter: a path avoiding every transit node stays inside both search spaces
+    const bool far = fw.valid[s] && bw.valid[t] &&
+                     (!fw.box[s].contains(g.getVertexPorIndice(t)) || !bw.box[t].contains(g.getVertexPorIndice(s)));
+    if (!far) return fallback.solveAStar(g, start, goal);
+
+    SolucionAStar res;
+    res.total_cost = INFINITY_DIST;
+    const size_t k = transit.size();
+    for (std::uint64_t i = fw.first[s]; i < fw.first[s + 1]; ++i) {
+        const Acceso& a = fw.nodes[i];
+        const Distance* row = table.data() + static_cast<size_t>(a.transit) * k;
+        for (std::uint64_t j = bw.first[t]; j < bw.first[t + 1]; ++j) {
+            const Acceso& b = bw.nodes[j];
+            if (row[b.transit] == INFINITY_DIST) continue;
+            res.total_cost = std::min(res.total_cost, a.dist + row[b.transit] + b.dist);
+        }
+    }
+
+    table_answers++;
+    if (por_tabla) *por_tabla = true;
+
+    auto t1 = std::chrono::high_resolution_clock::now();
+    res.elapsed = std::chrono::duration_cast<std::chrono::duration<double>>(t1 - t0).count();
+    return res;
+}
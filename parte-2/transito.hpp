@@ -0,0 +1,96 @@
+// transito.hpp
+#ifndef TRANSITO_HPP
+#define TRANSITO_HPP
+
+#include "tipos.hpp"
+#include "grafo.hpp"
+#include "algoritmo.hpp"
+
+#include <cstdint>
+#include <vector>
+
+// Transit-node routing.
+//  - Transit nodes: the vertices that hang the most shortest-path tree below them,
+//    summed over a sample of full Dijkstra trees (a sampled betweenness).
+//  - Access nodes of v: a Dijkstra from v (and one on the reverse arcs) where a label is
+//    covered once its path has gone through a transit node. The uncovered transit nodes it
+//    settles, with their distances, are the forward (backward) access nodes of v, and the
+//    search stops as soon as every queued label is covered. The bounding box of the uncovered
+//    settled vertices contains every goal whose shortest paths can all avoid the transit nodes.
+//  - Table: distance between every pair of transit nodes (one Dijkstra per transit node).
+//
+// Locality filter: if the goal lies outside the forward box of the start (or the start outside
+// the backward box of the goal), some shortest path crosses a transit node, and
+// min over access pairs (a, b) of d(s, a) + D[a][b] + d(b, t) is exact.
+// Otherwise, or when a search space was too large to be recorded, the query falls back to A*.
+//
+// Table answers are cost-only: total_cost is exact but path and costs are left empty
+// (unpacking would need the searches the table is there to avoid). Fallback answers carry the path.
+class RutasTransito {
+private:
+    struct Acceso {
+        std::uint32_t transit{}; // position in 'transit'
+        Distance dist{};
+    };
+
+    struct Caja {
+        Coordinate lat_min{}, lat_max{}, lon_min{}, lon_max{};
+
+        bool contains(const Vertex& v) const {
+            return v.latitude >= lat_min && v.latitude <= lat_max && v.longitude >= lon_min && v.longitude <= lon_max;
+        }
+    };
+
+    // Per direction (0 = forward, 1 = backward): access nodes in CSR and the search-space box.
+    // 'valid' is 0 for vertices whose pruned search hit the caps below.
+    struct Accesos {
+        std::vector<std::uint64_t> first;
+        std::vector<Acceso> nodes;
+        std::vector<Caja> box;
+        std::vector<unsigned char> valid;
+    };
+
+    static constexpr std::uint32_t NO_TRANSIT = ~std::uint32_t{0};
+    static constexpr size_t MAX_SEARCH_SPACE = 2048; // settled vertices per pruned search
+    static constexpr size_t MAX_ACCESS = 64;         // access nodes per vertex and direction
+    static constexpr size_t NUM_SAMPLES = 32;        // trees used to rank the vertices
+
+    const Grafo* grafo = nullptr;
+
+
+    std::vector<VertexID> transit;            // internal indices of the transit nodes
+    std::vector<std::uint32_t> transit_rank;  // per vertex: position in 'transit' or NO_TRANSIT
+    std::vector<Distance> table;              // transit x transit distances, row-major
+    Accesos access[2];
+
+    double build_time = 0.0;
+    size_t queries = 0;
+    size_t table_answers = 0;
+
+    Algoritmo fallback;
+
+    void selectTransit(size_t count, unsigned threads);
+    void buildAccess(unsigned threads);
+    void buildTable(unsigned threads);
+
+public:
+    RutasTransito() = default;
+
+    // 'g' must outlive this object
+    void build(const Grafo& g, size_t num_transit, unsigned threads);
+
+    // Exact distance; 'por_tabla' tells whether the table answered it (then without path)
+    SolucionAStar solve(VertexID start, VertexID goal, bool* por_tabla = nullptr);
+
+    size_t getNumTransit() const { return transit.size(); }
+    double getBuildTime() const { return build_time; }
+    size_t getTableBytes() const { return table.size() * sizeof(Distance); }
+    size_t getAccessBytes() const;
+    double getValidFraction() const;  // vertices whose both pruned searches completed
+    double getMeanAccessNodes() const; // forward access nodes per valid vertex
+
+    size_t getNumQueries() const { return queries; }
+    size_t getNumTableAnswers() const { return table_answers; }
+};
+
+#endif // TRANSITO_HPP